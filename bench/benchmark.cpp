@@ -0,0 +1,447 @@
+#include <iostream>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <vector>
+#include <cstdlib>
+#include <new>
+#include <sys/resource.h>
+
+#include "jogo.hpp"
+#include "contexto_partida.hpp"
+#include "nomes_configuracao.hpp"
+
+/*
+ * Benchmark do Jogo das Cadeiras.
+ *
+ * Executa partidas sem sleeps (música de 0ms) para cada combinação de modo de execução,
+ * estratégia de cadeiras, número de jogadores e número de threads do pool, durante um tempo
+ * fixo por combinação. Para cada uma reporta, em JSON, as latências por rodada (da parada
+ * da música até todos tentarem sentar e até os eliminados serem conhecidos), partidas e
+ * rodadas por segundo e as trocas de contexto do processo. "memoria_max_kb" é o pico de memória
+ * residente do processo até aquele ponto: para comparar threads e corrotinas, meça cada modo em
+ * uma execução separada.
+ *
+ * Partidas grandes são interrompidas após `--max-rodadas` rodadas (0 = sem limite), já que uma partida com
+ * N jogadores tem N-1 rodadas; o campo "completas" diz quantas chegaram a um vencedor.
+ * Com `--remover-pct`, cada rodada elimina essa porcentagem dos ativos e a partida tem
+ * O(log N) rodadas. Com `--largada`, no modo threads os jogadores acordados esperam em uma
+ * barreira e disputam as cadeiras ao mesmo tempo, o que mede as estratégias sob contenção real.
+ * Com `--sinal adaptativo`, cada resultado conta em "esperas" quantas esperas entre rodadas
+ * terminaram girando e quantas estacionaram.
+ *
+ * As partidas de uma combinação reaproveitam um ContextoPartida; "alocacoes_ultima_partida" conta
+ * as chamadas ao operator new global (alinhado ou não, de objeto ou de array) durante a última delas (0 em regime, exceto pelas tarefas do
+ * pool): o coordenador e as threads dos jogadores ficam estacionados entre partidas.
+ *
+ * "operacoes_bits" mede, para cada conjunto de instruções que a CPU suporta, as varreduras que o
+ * coordenador faz na `TabelaJogadores` a cada rodada, com 1M jogadores (mediana em ns): zerar as
+ * tentativas (reiniciar a rodada) e derivar a máscara de eliminados; "jogo" diz qual delas as
+ * partidas usam.
+ */
+
+// Contagem global de alocações, para verificar que partidas em sequência não alocam. Todas as
+// formas substituíveis passam por aqui: as alinhadas (tipos `alignas(64)` como os slots e
+// fragmentos das cadeiras) e as de arrays também contam, e cada delete combina com o seu new
+static std::atomic<std::uint64_t> total_alocacoes{0};
+
+static void* alocar(std::size_t tamanho){
+    total_alocacoes.fetch_add(1, std::memory_order_relaxed);
+    if (void *p = std::malloc(tamanho ? tamanho : 1)) return p;
+    throw std::bad_alloc();
+}
+
+static void* alocar_alinhado(std::size_t tamanho, std::align_val_t alinhamento){
+    total_alocacoes.fetch_add(1, std::memory_order_relaxed);
+    const std::size_t a = static_cast<std::size_t>(alinhamento);
+    // aligned_alloc exige um tamanho múltiplo do alinhamento
+    const std::size_t arredondado = ((tamanho ? tamanho : 1) + a - 1) / a * a;
+    if (void *p = std::aligned_alloc(a, arredondado)) return p;
+    throw std::bad_alloc();
+}
+
+void* operator new(std::size_t tamanho){
+    return alocar(tamanho);
+}
+
+void* operator new[](std::size_t tamanho){
+    return alocar(tamanho);
+}
+
+void* operator new(std::size_t tamanho, std::align_val_t alinhamento){
+    return alocar_alinhado(tamanho, alinhamento);
+}
+
+void* operator new[](std::size_t tamanho, std::align_val_t alinhamento){
+    return alocar_alinhado(tamanho, alinhamento);
+}
+
+void operator delete(void *p) noexcept{
+    std::free(p);
+}
+
+void operator delete[](void *p) noexcept{
+    std::free(p);
+}
+
+void operator delete(void *p, std::size_t) noexcept{
+    std::free(p);
+}
+
+void operator delete[](void *p, std::size_t) noexcept{
+    std::free(p);
+}
+
+void operator delete(void *p, std::align_val_t) noexcept{
+    std::free(p);
+}
+
+void operator delete[](void *p, std::align_val_t) noexcept{
+    std::free(p);
+}
+
+void operator delete(void *p, std::size_t, std::align_val_t) noexcept{
+    std::free(p);
+}
+
+void operator delete[](void *p, std::size_t, std::align_val_t) noexcept{
+    std::free(p);
+}
+
+struct OpcoesBenchmark
+{
+    std::vector<long> jogadores{4, 16, 64, 256, 1024, 4096, 16384, 65536, 262144, 1048576};
+    std::vector<long> threads;
+    std::vector<ModoExecucao> modos{ModoExecucao::Pool};
+    std::vector<EstrategiaCadeiras> estrategias{EstrategiaCadeiras::Semaforo, EstrategiaCadeiras::Contador,
+                                                EstrategiaCadeiras::Vetor, EstrategiaCadeiras::PorNo,
+                                                EstrategiaCadeiras::Hierarquico};
+    bool simulado = true;
+    TipoSinal sinal = TipoSinal::Atomico;
+    int max_rodadas = 64;
+    int tempo_ms = 500;
+    int espera_ms = 0;
+    bool instrumentar = false;
+    bool fixar_cpus = false;
+    bool largada = false;
+    bool inicio_rapido = false;
+    int percentual_remocao = 0; // 0: uma cadeira por rodada
+    long max_jogadores_threads = 1024; // acima disso o modo threads é pulado
+    std::string saida;
+};
+
+struct Percentis
+{
+    std::uint64_t p50 = 0, p90 = 0, p99 = 0, max = 0;
+};
+
+Percentis calcular_percentis(std::vector<std::uint64_t> &amostras){
+    Percentis p;
+    if (amostras.empty()) return p;
+    std::sort(amostras.begin(), amostras.end());
+    auto q = [&](double f) { return amostras[static_cast<std::size_t>(f * (amostras.size() - 1))]; };
+    p.p50 = q(0.50);
+    p.p90 = q(0.90);
+    p.p99 = q(0.99);
+    p.max = amostras.back();
+    return p;
+}
+
+std::string para_json(const Percentis &p){
+    std::ostringstream out;
+    out << "{\"p50\": " << p.p50 << ", \"p90\": " << p.p90 << ", \"p99\": " << p.p99 << ", \"max\": " << p.max << "}";
+    return out.str();
+}
+
+bool ler_lista(const std::string &valor, std::vector<long> &saida){
+    saida.clear();
+    std::stringstream ss(valor);
+    std::string item;
+    while (std::getline(ss, item, ',')){
+        char *fim = nullptr;
+        long n = std::strtol(item.c_str(), &fim, 10);
+        if (fim == item.c_str() || *fim != '\0' || n < 1) return false;
+        saida.push_back(n);
+    }
+    return !saida.empty();
+}
+
+void exibir_uso(const char *programa){
+    std::cerr << "Uso: " << programa << " [opções]\n"
+              << "  --jogadores A,B,...   números de jogadores (padrão 4,16,...,1048576)\n"
+              << "  --threads A,B,...     threads do pool (padrão 1,2,4,...,hardware_concurrency())\n"
+              << "  --modos LISTA         threads,pool,corrotina,simulado (padrão pool,simulado)\n"
+              << "  --cadeiras LISTA      semaforo,contador,vetor,numa,hierarquico (padrão todas)\n"
+              << "  --max-rodadas N       rodadas por partida antes de interromper (padrão 64; 0 = sem limite)\n"
+              << "  --tempo-ms MS         tempo de medição por combinação (padrão 500)\n"
+              << "  --espera MS           pausa extra após todos tentarem, no modo threads (padrão 0)\n"
+              << "  --remover-pct P       remove P% dos ativos por rodada em vez de uma cadeira\n"
+              << "  --fixar               fixa as threads em núcleos, nó NUMA a nó\n"
+              << "  --largada             modo threads: barreira de largada antes da disputa\n"
+              << "  --inicio-rapido       prepara arena e threads antes de cada primeira partida\n"
+              << "  --sinal cv|atomico|adaptativo\n"
+              << "                        espera dos jogadores no modo threads (padrão atomico)\n"
+              << "  --instrumentar        inclui os histogramas por thread (despertar, resultado, ...)\n"
+              << "  --saida ARQUIVO       grava o JSON no arquivo em vez da saída padrão\n";
+}
+
+bool ler_opcoes(int argc, char **argv, OpcoesBenchmark &opcoes){
+    for (int i = 1; i < argc; ++i){
+        std::string arg = argv[i];
+        if (arg == "--instrumentar"){
+            opcoes.instrumentar = true;
+            continue;
+        }
+        if (arg == "--fixar"){
+            opcoes.fixar_cpus = true;
+            continue;
+        }
+        if (arg == "--largada"){
+            opcoes.largada = true;
+            continue;
+        }
+        if (arg == "--inicio-rapido"){
+            opcoes.inicio_rapido = true;
+            continue;
+        }
+        if (i + 1 >= argc) return false;
+        std::string valor = argv[++i];
+        std::vector<long> numeros;
+
+        if (arg == "--jogadores"){
+            if (!ler_lista(valor, opcoes.jogadores)) return false;
+            for (long n : opcoes.jogadores) if (n < 2) return false;
+        } else if (arg == "--threads"){
+            if (!ler_lista(valor, opcoes.threads)) return false;
+        } else if (arg == "--modos"){
+            opcoes.modos.clear();
+            opcoes.simulado = false;
+            std::stringstream ss(valor);
+            std::string item;
+            while (std::getline(ss, item, ',')){
+                ModoExecucao modo{};
+                if (item == "simulado") opcoes.simulado = true;
+                else if (ler_modo(item, modo)) opcoes.modos.push_back(modo);
+                else return false;
+            }
+        } else if (arg == "--cadeiras"){
+            if (!ler_estrategias(valor, opcoes.estrategias)) return false;
+        } else if (arg == "--max-rodadas"){
+            long n = 0;
+            if (!ler_inteiro(valor, 0, 100000000, n)) return false;
+            opcoes.max_rodadas = static_cast<int>(n);
+        } else if (arg == "--tempo-ms" && ler_lista(valor, numeros)){
+            opcoes.tempo_ms = static_cast<int>(numeros[0]);
+        } else if (arg == "--espera"){
+            char *fim = nullptr;
+            opcoes.espera_ms = static_cast<int>(std::strtol(valor.c_str(), &fim, 10));
+            if (fim == valor.c_str() || *fim != '\0' || opcoes.espera_ms < 0) return false;
+        } else if (arg == "--remover-pct" && ler_lista(valor, numeros) && numeros[0] < 100){
+            opcoes.percentual_remocao = static_cast<int>(numeros[0]);
+        } else if (arg == "--sinal"){
+            if (!ler_sinal(valor, opcoes.sinal)) return false;
+        } else if (arg == "--saida"){
+            opcoes.saida = valor;
+        } else {
+            return false;
+        }
+    }
+
+    if (opcoes.threads.empty()){
+        long hw = std::max(1u, std::thread::hardware_concurrency());
+        for (long t = 1; t < hw; t *= 2) opcoes.threads.push_back(t);
+        opcoes.threads.push_back(hw);
+    }
+    return true;
+}
+
+// Mede uma combinação durante `tempo_ms` (pelo menos uma partida) e devolve o objeto JSON
+std::string medir(const Configuracao &config, long threads, int tempo_ms){
+    std::vector<std::uint64_t> sentados, eliminacao, inicios_quentes;
+    std::uint64_t inicio_frio = 0; // a primeira partida do contexto cria threads e arena
+    long partidas = 0, completas = 0, rodadas = 0;
+    std::uint64_t esperas_girando = 0, esperas_estacionadas = 0;
+    std::uint64_t alocacoes_ultima = 0;
+    ContextoPartida contexto;
+
+    Instrumentacao::instancia().zerar();
+    rusage antes{}, depois{};
+    getrusage(RUSAGE_SELF, &antes);
+    const std::uint64_t inicio = agora_ns();
+    std::uint64_t decorrido = 0;
+
+    do {
+        const std::uint64_t alocacoes_antes = total_alocacoes.load(std::memory_order_relaxed);
+        const ResultadoPartida &resultado = contexto.executar(config);
+        alocacoes_ultima = total_alocacoes.load(std::memory_order_relaxed) - alocacoes_antes;
+        if (partidas == 0){
+            inicio_frio = resultado.ate_primeira_rodada_ns;
+        } else {
+            inicios_quentes.push_back(resultado.ate_primeira_rodada_ns);
+        }
+        partidas++;
+        rodadas += resultado.rodadas;
+        if (resultado.vencedor > 0) completas++;
+        esperas_girando += resultado.esperas_girando;
+        esperas_estacionadas += resultado.esperas_estacionadas;
+        for (const auto &r : resultado.estatisticas){
+            if (r.ate_todos_sentados_ns) sentados.push_back(r.ate_todos_sentados_ns);
+            eliminacao.push_back(r.ate_eliminacao_ns);
+        }
+        decorrido = agora_ns() - inicio;
+    } while (decorrido < static_cast<std::uint64_t>(tempo_ms) * 1000000ull);
+
+    getrusage(RUSAGE_SELF, &depois);
+    const double segundos = decorrido / 1e9;
+
+    std::ostringstream out;
+    out << "    {\"modo\": \"" << nome_modo(config.modo, config.simulado) << "\""
+        << ", \"cadeiras\": \"" << nome_estrategia(config.estrategia) << "\""
+        << ", \"jogadores\": " << config.num_jogadores
+        << ", \"threads\": " << threads
+        << ", \"partidas\": " << partidas
+        << ", \"completas\": " << completas
+        << ", \"rodadas\": " << rodadas
+        << ", \"segundos\": " << segundos
+        << ", \"partidas_por_s\": " << partidas / segundos
+        << ", \"rodadas_por_s\": " << rodadas / segundos
+        << ", \"latencia_sentados_ns\": " << para_json(calcular_percentis(sentados))
+        << ", \"latencia_eliminacao_ns\": " << para_json(calcular_percentis(eliminacao))
+        << ", \"ate_primeira_rodada_ns\": {\"fria\": " << inicio_frio
+        << ", \"quente_p50\": " << calcular_percentis(inicios_quentes).p50 << "}"
+        << ", \"trocas_contexto\": {\"voluntarias\": " << depois.ru_nvcsw - antes.ru_nvcsw
+        << ", \"involuntarias\": " << depois.ru_nivcsw - antes.ru_nivcsw << "}"
+        << ", \"memoria_max_kb\": " << depois.ru_maxrss
+        << ", \"alocacoes_ultima_partida\": " << alocacoes_ultima
+        << ", \"arena_kb\": " << contexto.capacidade() / 1024;
+    if (config.sinal == TipoSinal::Adaptativo){
+        out << ", \"esperas\": {\"girando\": " << esperas_girando
+            << ", \"estacionadas\": " << esperas_estacionadas << "}";
+    }
+    if (config.instrumentar){
+        out << ", \"instrumentacao\": " << Instrumentacao::instancia().para_json();
+    }
+    out << "}";
+    return out.str();
+}
+
+// Mediana de `repeticoes` execuções de `operacao`, em ns
+template <typename Operacao>
+std::uint64_t mediana_ns(int repeticoes, Operacao &&operacao){
+    std::vector<std::uint64_t> amostras;
+    for (int i = 0; i < repeticoes; ++i){
+        const std::uint64_t inicio = agora_ns();
+        operacao();
+        amostras.push_back(agora_ns() - inicio);
+    }
+    return calcular_percentis(amostras).p50;
+}
+
+std::string medir_operacoes_bits(){
+    constexpr std::size_t jogadores = 1048576;
+    constexpr std::size_t palavras = jogadores / 64;
+    std::vector<std::uint64_t> tentaram(palavras), ativos(palavras), mascara(palavras), tentativas(palavras);
+    std::mt19937_64 gen(1);
+    for (std::size_t i = 0; i < palavras; ++i){
+        tentaram[i] = gen();
+        ativos[i] = tentaram[i] & gen(); // cerca de metade de quem tentou foi eliminada
+    }
+
+    std::ostringstream out;
+    out << "{\"jogo\": \"" << OperacoesBits::nome(OperacoesBits::atual().get_conjunto()) << "\", \"jogadores\": "
+        << jogadores << ", \"conjuntos\": [";
+    bool primeiro = true;
+    for (ConjuntoInstrucoes conjunto : {ConjuntoInstrucoes::Escalar, ConjuntoInstrucoes::Avx2, ConjuntoInstrucoes::Avx512}){
+        if (!OperacoesBits::suporta(conjunto)) continue;
+        const OperacoesBits operacoes = OperacoesBits::para(conjunto);
+        std::size_t eliminados = 0;
+        const std::uint64_t zerar = mediana_ns(201, [&] { operacoes.zerar(tentativas.data(), palavras); });
+        const std::uint64_t diferenca = mediana_ns(201, [&] {
+            eliminados = operacoes.diferenca(mascara.data(), tentaram.data(), ativos.data(), palavras);
+        });
+        out << (primeiro ? "" : ", ") << "{\"conjunto\": \"" << OperacoesBits::nome(conjunto) << "\""
+            << ", \"zerar_ns\": " << zerar << ", \"eliminados_ns\": " << diferenca
+            << ", \"eliminados\": " << eliminados << "}";
+        primeiro = false;
+    }
+    out << "]}";
+    return out.str();
+}
+
+int main(int argc, char **argv){
+    OpcoesBenchmark opcoes;
+    if (!ler_opcoes(argc, argv, opcoes)){
+        exibir_uso(argv[0]);
+        return 1;
+    }
+
+    Registro::instancia().set_ativo(false);
+
+    std::vector<std::string> resultados;
+    for (EstrategiaCadeiras estrategia : opcoes.estrategias){
+        for (long jogadores : opcoes.jogadores){
+            Configuracao config;
+            config.num_jogadores = static_cast<int>(jogadores);
+            config.estrategia = estrategia;
+            config.sinal = opcoes.sinal;
+            config.musica_min_ms = 0;
+            config.musica_max_ms = 0;
+            config.espera_ms = opcoes.espera_ms;
+            config.max_rodadas = opcoes.max_rodadas;
+            config.coletar_estatisticas = true;
+            config.instrumentar = opcoes.instrumentar;
+            config.fixar_cpus = opcoes.fixar_cpus;
+            config.largada = opcoes.largada;
+            config.inicio_rapido = opcoes.inicio_rapido;
+            config.remocao.percentual = opcoes.percentual_remocao;
+            config.tem_semente = true;
+            config.semente = 1;
+
+            for (ModoExecucao modo : opcoes.modos){
+                config.modo = modo;
+                config.simulado = false;
+                if (modo == ModoExecucao::Threads){
+                    if (jogadores > opcoes.max_jogadores_threads) continue;
+                    config.num_threads = 0;
+                    resultados.push_back(medir(config, jogadores, opcoes.tempo_ms));
+                    std::cerr << resultados.back() << "\n";
+                    continue;
+                }
+                for (long threads : opcoes.threads){
+                    config.num_threads = static_cast<unsigned>(threads);
+                    resultados.push_back(medir(config, threads, opcoes.tempo_ms));
+                    std::cerr << resultados.back() << "\n";
+                }
+            }
+
+            if (opcoes.simulado){
+                config.simulado = true;
+                config.num_threads = 0;
+                resultados.push_back(medir(config, 1, opcoes.tempo_ms));
+                std::cerr << resultados.back() << "\n";
+            }
+        }
+    }
+
+    std::ostringstream json;
+    json << "{\n  \"hardware_concurrency\": " << std::thread::hardware_concurrency()
+         << ",\n  \"nos_numa\": " << Topologia::sistema().num_nos()
+         << ",\n  \"max_rodadas\": " << opcoes.max_rodadas
+         << ",\n  \"remocao_pct\": " << opcoes.percentual_remocao
+         << ",\n  \"largada\": " << (opcoes.largada ? "true" : "false")
+         << ",\n  \"inicio_rapido\": " << (opcoes.inicio_rapido ? "true" : "false")
+         << ",\n  \"sinal\": \"" << nome_sinal(opcoes.sinal) << "\""
+         << ",\n  \"operacoes_bits\": " << medir_operacoes_bits()
+         << ",\n  \"resultados\": [\n";
+    for (std::size_t i = 0; i < resultados.size(); ++i){
+        json << resultados[i] << (i + 1 < resultados.size() ? ",\n" : "\n");
+    }
+    json << "  ]\n}\n";
+
+    if (opcoes.saida.empty()){
+        std::cout << json.str();
+    } else {
+        std::ofstream(opcoes.saida) << json.str();
+    }
+    return 0;
+}
@@ -0,0 +1,366 @@
+#include <iostream>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <vector>
+#include <atomic>
+#include <barrier>
+#include <cstdlib>
+#include <random>
+#include <thread>
+
+#include "jogo.hpp"
+#include "contexto_partida.hpp"
+#include "nomes_configuracao.hpp"
+
+/*
+ * Teste de estresse das estratégias de cadeiras.
+ *
+ * Otimizar `ocupar`, `nova_rodada` ou a liberação do semáforo pode perder ou duplicar cadeiras
+ * sem que nenhuma partida trave; este executável verifica, sob carga, que cada rodada senta
+ * exatamente `cadeiras` jogadores e elimina exatamente o resto. Ele tem duas partes:
+ *
+ * - "disputas": para cada estratégia, `--threads` threads disputam a mesma política diretamente,
+ *   por `--rodadas` rodadas sorteadas (ativos, cadeiras e, em uma a cada oito rodadas, só parte
+ *   dos ativos tentando, o que deixa cadeiras sobrando para `nova_rodada` drenar). Cada rodada
+ *   confere quantos sentaram e foram eliminados e se alguma cadeira foi entregue duas vezes ou
+ *   fora da faixa da rodada. Entre as rodadas as threads esperam em uma `std::barrier`, que faz o
+ *   papel do coordenador.
+ * - "partidas": para cada estratégia e modo de execução, `--partidas` partidas completas com
+ *   música de 0ms, jogadores, remoção de cadeiras e sinal sorteados, pelo mesmo `ContextoPartida`
+ *   do benchmark. Cada partida confere, rodada a rodada, que os ativos da rodada seguinte são
+ *   exatamente as cadeiras da anterior e que sobra um único vencedor, o que passa por
+ *   `verificar_eliminacao`, `processar_eliminacoes` e `iniciar_rodada`. Uma partida que deixa de
+ *   eliminar é interrompida após N rodadas e conta como falha, em vez de não terminar.
+ *
+ * O JSON reporta as vazões de cada estratégia (rodadas e tentativas por segundo, partidas e rodadas
+ * por segundo) e as falhas; a primeira falha de cada combinação é descrita na saída de erro, com a
+ * semente que reproduz os sorteios. O código de saída é 1 se houve qualquer falha.
+ */
+
+struct OpcoesEstresse
+{
+    std::vector<EstrategiaCadeiras> estrategias{EstrategiaCadeiras::Semaforo, EstrategiaCadeiras::Contador,
+                                                EstrategiaCadeiras::Vetor, EstrategiaCadeiras::PorNo,
+                                                EstrategiaCadeiras::Hierarquico};
+    long rodadas = 1000000;  // rodadas de disputa por estratégia
+    long partidas = 500;     // partidas por estratégia e modo
+    long max_jogadores = 256;
+    long max_jogadores_threads = 32; // modo threads: uma thread por jogador
+    unsigned threads = 0;            // 0 = hardware_concurrency(), ao menos 2
+    std::uint64_t semente = 0;
+    bool tem_semente = false;
+    std::string saida;
+};
+
+void exibir_uso(const char *programa){
+    std::cerr << "Uso: " << programa << " [opções]\n"
+              << "  --cadeiras LISTA      semaforo,contador,vetor,numa,hierarquico (padrão todas)\n"
+              << "  --rodadas N           rodadas de disputa por estratégia (padrão 1000000)\n"
+              << "  --partidas N          partidas por estratégia e modo (padrão 500; 0 = nenhuma)\n"
+              << "  --jogadores N         máximo de jogadores por rodada ou partida (padrão 256)\n"
+              << "  --threads N           threads da disputa e do pool (padrão hardware_concurrency(), ao menos 2)\n"
+              << "  --semente S           semente dos sorteios (padrão aleatória, reportada no JSON)\n"
+              << "  --saida ARQUIVO       grava o JSON no arquivo em vez da saída padrão\n";
+}
+
+bool ler_opcoes(int argc, char **argv, OpcoesEstresse &opcoes){
+    for (int i = 1; i < argc; ++i){
+        std::string arg = argv[i];
+        if (i + 1 >= argc) return false;
+        std::string valor = argv[++i];
+        long numero = 0;
+
+        if (arg == "--cadeiras"){
+            if (!ler_estrategias(valor, opcoes.estrategias)) return false;
+        } else if (arg == "--rodadas" && ler_inteiro(valor, 0, 1000000000000, numero)){
+            opcoes.rodadas = numero;
+        } else if (arg == "--partidas" && ler_inteiro(valor, 0, 1000000000, numero)){
+            opcoes.partidas = numero;
+        } else if (arg == "--jogadores" && ler_inteiro(valor, 2, 1000000, numero)){
+            opcoes.max_jogadores = numero;
+        } else if (arg == "--threads" && ler_inteiro(valor, 1, 4096, numero)){
+            opcoes.threads = static_cast<unsigned>(numero);
+        } else if (arg == "--semente" && ler_semente(valor, opcoes.semente)){
+            opcoes.tem_semente = true;
+        } else if (arg == "--saida"){
+            opcoes.saida = valor;
+        } else {
+            return false;
+        }
+    }
+
+    if (opcoes.threads == 0){
+        opcoes.threads = std::max(2u, std::thread::hardware_concurrency());
+    }
+    if (!opcoes.tem_semente){
+        opcoes.semente = std::random_device{}();
+    }
+    return true;
+}
+
+// Falhas encontradas por `disputar`, por tipo
+struct FalhasDisputa
+{
+    std::uint64_t contagem = 0;     // rodadas em que sentados ou eliminados não bateram
+    std::uint64_t duplicadas = 0;   // cadeiras entregues a mais de um jogador na mesma rodada
+    std::uint64_t fora_da_faixa = 0; // cadeiras fora de 1..cadeiras (ou do limite do hierárquico)
+
+    std::uint64_t total() const{
+        return contagem + duplicadas + fora_da_faixa;
+    }
+};
+
+// `threads` threads disputam uma mesma `Politica` por `rodadas` rodadas sorteadas e devolvem o
+// objeto JSON da estratégia
+template <PoliticaCadeiras Politica>
+std::string disputar(const OpcoesEstresse &opcoes, std::uint64_t &total_falhas){
+    const int max_jogadores = static_cast<int>(opcoes.max_jogadores);
+    // O hierárquico numera as cadeiras como `fragmento + ordem * fragmentos`, com até 64 fragmentos
+    const bool contigua = Politica::estrategia != EstrategiaCadeiras::Hierarquico;
+    const int limite = 64 * (max_jogadores + 1) + 1;
+
+    Politica politica(static_cast<std::uint32_t>(max_jogadores - 1), std::pmr::get_default_resource());
+    std::vector<std::atomic<std::uint32_t>> marcas(static_cast<std::size_t>(limite)); // rodada em que cada cadeira foi ocupada
+
+    // Escritos pelo coordenador antes da primeira barreira da rodada e lidos pelas threads depois dela
+    int tentam = 0;
+    int cadeiras = 0;
+    std::uint32_t rodada = 0;
+    bool encerrar = false;
+
+    std::atomic<int> proximo{0};
+    std::atomic<int> sentados{0}, eliminados{0};
+    std::atomic<std::uint64_t> duplicadas{0}, fora_da_faixa{0};
+    std::barrier sincronia(static_cast<std::ptrdiff_t>(opcoes.threads) + 1);
+
+    auto disputar_rodadas = [&] {
+        for (;;){
+            sincronia.arrive_and_wait();
+            if (encerrar) return;
+            int sentados_thread = 0, eliminados_thread = 0;
+            for (int i; (i = proximo.fetch_add(1, std::memory_order_relaxed)) < tentam;){
+                const int cadeira = politica.ocupar(i + 1);
+                if (!cadeira){
+                    eliminados_thread++;
+                    continue;
+                }
+                sentados_thread++;
+                if (cadeira < 0 || cadeira >= limite || (contigua && cadeira > cadeiras)){
+                    fora_da_faixa.fetch_add(1, std::memory_order_relaxed);
+                } else if (marcas[cadeira].exchange(rodada, std::memory_order_relaxed) == rodada){
+                    duplicadas.fetch_add(1, std::memory_order_relaxed);
+                }
+            }
+            sentados.fetch_add(sentados_thread, std::memory_order_relaxed);
+            eliminados.fetch_add(eliminados_thread, std::memory_order_relaxed);
+            sincronia.arrive_and_wait();
+        }
+    };
+
+    std::vector<std::thread> threads;
+    for (unsigned t = 0; t < opcoes.threads; ++t){
+        threads.emplace_back(disputar_rodadas);
+    }
+
+    std::mt19937_64 gen(opcoes.semente);
+    std::uniform_int_distribution<int> dist_ativos(2, max_jogadores);
+    FalhasDisputa falhas;
+    std::uint64_t tentativas = 0;
+    bool descrita = false;
+
+    const std::uint64_t disputas_antes = Disputas::instancia().total(); // contadas por thread, no processo todo
+    const std::uint64_t inicio = agora_ns();
+    for (long r = 0; r < opcoes.rodadas; ++r){
+        const int ativos = dist_ativos(gen);
+        // Metade das rodadas remove uma cadeira, como o jogo original; a outra remove uma quantidade sorteada
+        cadeiras = gen() % 2 ? ativos - 1 : std::uniform_int_distribution<int>(1, ativos - 1)(gen);
+        // Uma em cada oito rodadas fica incompleta: pode sobrar cadeira para a próxima `nova_rodada`
+        tentam = gen() % 8 ? ativos : std::uniform_int_distribution<int>(0, ativos)(gen);
+        rodada++;
+        proximo.store(0, std::memory_order_relaxed);
+        sentados.store(0, std::memory_order_relaxed);
+        eliminados.store(0, std::memory_order_relaxed);
+        politica.nova_rodada(static_cast<std::uint32_t>(cadeiras));
+
+        sincronia.arrive_and_wait(); // largada
+        sincronia.arrive_and_wait(); // todos tentaram
+
+        const int esperados = std::min(tentam, cadeiras);
+        const int sentados_rodada = sentados.load(std::memory_order_relaxed);
+        const int eliminados_rodada = eliminados.load(std::memory_order_relaxed);
+        if (sentados_rodada != esperados || eliminados_rodada != tentam - esperados){
+            falhas.contagem++;
+            if (!descrita){
+                std::cerr << nome_estrategia(Politica::estrategia) << ": rodada " << r + 1 << " com " << ativos
+                          << " ativos, " << tentam << " tentativas e " << cadeiras << " cadeiras: " << sentados_rodada
+                          << " sentados e " << eliminados_rodada << " eliminados (semente " << opcoes.semente << ")\n";
+                descrita = true;
+            }
+        }
+        tentativas += static_cast<std::uint64_t>(tentam);
+    }
+    const double segundos = (agora_ns() - inicio) / 1e9;
+
+    encerrar = true;
+    sincronia.arrive_and_wait();
+    for (auto &thread : threads){
+        thread.join();
+    }
+
+    falhas.duplicadas = duplicadas.load();
+    falhas.fora_da_faixa = fora_da_faixa.load();
+    total_falhas += falhas.total();
+
+    std::ostringstream out;
+    out << "    {\"cadeiras\": \"" << nome_estrategia(Politica::estrategia) << "\""
+        << ", \"rodadas\": " << opcoes.rodadas
+        << ", \"tentativas\": " << tentativas
+        << ", \"segundos\": " << segundos
+        << ", \"rodadas_por_s\": " << (segundos > 0 ? opcoes.rodadas / segundos : 0)
+        << ", \"tentativas_por_s\": " << (segundos > 0 ? tentativas / segundos : 0)
+        << ", \"disputas\": " << Disputas::instancia().total() - disputas_antes
+        << ", \"falhas\": {\"contagem\": " << falhas.contagem << ", \"duplicadas\": " << falhas.duplicadas
+        << ", \"fora_da_faixa\": " << falhas.fora_da_faixa << "}}";
+    return out.str();
+}
+
+// Confere uma partida rodada a rodada; devolve a descrição da primeira inconsistência ou "" se não há
+std::string verificar_partida(const Configuracao &config, const ResultadoPartida &resultado){
+    std::ostringstream erro;
+    const auto &estatisticas = resultado.estatisticas;
+    if (estatisticas.size() != static_cast<std::size_t>(resultado.rodadas) || estatisticas.empty()){
+        erro << resultado.rodadas << " rodadas e " << estatisticas.size() << " estatísticas";
+        return erro.str();
+    }
+    if (estatisticas[0].jogadores != config.num_jogadores){
+        erro << "primeira rodada com " << estatisticas[0].jogadores << " ativos";
+        return erro.str();
+    }
+    for (std::size_t i = 0; i < estatisticas.size(); ++i){
+        const EstatisticaRodada &rodada = estatisticas[i];
+        // Quem sentou é exatamente quem está ativo na rodada seguinte (ou o vencedor, depois da última)
+        const int sobreviventes = i + 1 < estatisticas.size() ? estatisticas[i + 1].jogadores : 1;
+        if (rodada.cadeiras != config.remocao.cadeiras_para(rodada.jogadores) ||
+            (i + 1 < estatisticas.size() && sobreviventes != rodada.cadeiras)){
+            erro << "rodada " << i + 1 << " com " << rodada.jogadores << " ativos e " << rodada.cadeiras
+                 << " cadeiras deixou " << sobreviventes << " ativos";
+            return erro.str();
+        }
+    }
+    if (resultado.vencedor < 1 || resultado.vencedor > config.num_jogadores || estatisticas.back().cadeiras != 1){
+        erro << "terminou após " << resultado.rodadas << " rodadas com vencedor " << resultado.vencedor;
+    }
+    return erro.str();
+}
+
+// Joga `opcoes.partidas` partidas sorteadas de uma estratégia em um modo e devolve o objeto JSON
+std::string jogar_partidas(const OpcoesEstresse &opcoes, EstrategiaCadeiras estrategia, ModoExecucao modo,
+                           bool simulado, std::uint64_t &total_falhas){
+    const bool com_threads = modo == ModoExecucao::Threads && !simulado;
+    const int max_jogadores = static_cast<int>(com_threads ? std::min(opcoes.max_jogadores, opcoes.max_jogadores_threads)
+                                                           : opcoes.max_jogadores);
+    std::mt19937_64 gen(opcoes.semente);
+    std::uniform_int_distribution<int> dist_jogadores(2, max_jogadores);
+    constexpr int percentuais[] = {0, 0, 10, 25, 50};
+    constexpr TipoSinal sinais[] = {TipoSinal::VariavelCondicao, TipoSinal::Atomico, TipoSinal::Adaptativo};
+
+    Configuracao config;
+    config.estrategia = estrategia;
+    config.modo = modo;
+    config.simulado = simulado;
+    config.num_threads = com_threads || simulado ? 0 : opcoes.threads;
+    config.musica_min_ms = 0;
+    config.musica_max_ms = 0;
+    config.coletar_estatisticas = true;
+    config.tem_semente = true;
+
+    ContextoPartida contexto;
+    std::uint64_t falhas = 0, rodadas = 0;
+    const std::uint64_t inicio = agora_ns();
+    for (long p = 0; p < opcoes.partidas; ++p){
+        config.num_jogadores = dist_jogadores(gen);
+        // Uma partida correta termina em no máximo N-1 rodadas; uma que não elimina ninguém não termina
+        config.max_rodadas = config.num_jogadores;
+        config.remocao.percentual = percentuais[gen() % std::size(percentuais)];
+        config.sinal = sinais[gen() % std::size(sinais)];
+        config.largada = com_threads && gen() % 2;
+        config.semente = gen();
+
+        const ResultadoPartida &resultado = contexto.executar(config);
+        rodadas += static_cast<std::uint64_t>(resultado.rodadas);
+        const std::string erro = verificar_partida(config, resultado);
+        if (!erro.empty()){
+            if (falhas == 0){
+                std::cerr << nome_estrategia(estrategia) << "/" << nome_modo(modo, simulado) << ": partida " << p + 1
+                          << " com " << config.num_jogadores << " jogadores: " << erro << " (semente " << opcoes.semente << ")\n";
+            }
+            falhas++;
+        }
+    }
+    const double segundos = (agora_ns() - inicio) / 1e9;
+    total_falhas += falhas;
+
+    std::ostringstream out;
+    out << "    {\"cadeiras\": \"" << nome_estrategia(estrategia) << "\""
+        << ", \"modo\": \"" << nome_modo(modo, simulado) << "\""
+        << ", \"partidas\": " << opcoes.partidas
+        << ", \"rodadas\": " << rodadas
+        << ", \"segundos\": " << segundos
+        << ", \"partidas_por_s\": " << (segundos > 0 ? opcoes.partidas / segundos : 0)
+        << ", \"rodadas_por_s\": " << (segundos > 0 ? rodadas / segundos : 0)
+        << ", \"falhas\": " << falhas << "}";
+    return out.str();
+}
+
+int main(int argc, char **argv){
+    OpcoesEstresse opcoes;
+    if (!ler_opcoes(argc, argv, opcoes)){
+        exibir_uso(argv[0]);
+        return 1;
+    }
+
+    Registro::instancia().set_ativo(false);
+
+    std::uint64_t falhas = 0;
+    std::vector<std::string> disputas, partidas;
+    for (EstrategiaCadeiras estrategia : opcoes.estrategias){
+        disputas.push_back(com_politica(estrategia, [&]<typename Politica>() {
+            return disputar<Politica>(opcoes, falhas);
+        }));
+        std::cerr << disputas.back() << "\n";
+
+        if (opcoes.partidas == 0) continue;
+        for (ModoExecucao modo : {ModoExecucao::Threads, ModoExecucao::Pool, ModoExecucao::Corrotina}){
+            partidas.push_back(jogar_partidas(opcoes, estrategia, modo, false, falhas));
+            std::cerr << partidas.back() << "\n";
+        }
+        partidas.push_back(jogar_partidas(opcoes, estrategia, ModoExecucao::Pool, true, falhas));
+        std::cerr << partidas.back() << "\n";
+    }
+
+    auto lista = [](const std::vector<std::string> &itens) {
+        std::string saida;
+        for (std::size_t i = 0; i < itens.size(); ++i){
+            saida += itens[i] + (i + 1 < itens.size() ? ",\n" : "\n");
+        }
+        return saida;
+    };
+
+    std::ostringstream json;
+    json << "{\n  \"hardware_concurrency\": " << std::thread::hardware_concurrency()
+         << ",\n  \"threads\": " << opcoes.threads
+         << ",\n  \"max_jogadores\": " << opcoes.max_jogadores
+         << ",\n  \"semente\": " << opcoes.semente
+         << ",\n  \"falhas\": " << falhas
+         << ",\n  \"disputas\": [\n" << lista(disputas)
+         << "  ],\n  \"partidas\": [\n" << lista(partidas)
+         << "  ]\n}\n";
+
+    if (opcoes.saida.empty()){
+        std::cout << json.str();
+    } else {
+        std::ofstream(opcoes.saida) << json.str();
+    }
+    return falhas == 0 ? 0 : 1;
+}
@@ -0,0 +1,204 @@
+#include <arpa/inet.h>
+#include <fcntl.h>
+#include <netinet/in.h>
+#include <sys/mman.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include <cerrno>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <string>
+#include <thread>
+
+#include "metricas.hpp"
+#include "relogio.hpp"
+
+/*
+ * Leitor das métricas ao vivo do Jogo das Cadeiras (`JogoDasCadeiras --metricas NOME`).
+ *
+ * Mapeia o bloco /dev/shm/NOME só para leitura, copia uma fotografia consistente (repetindo a
+ * leitura se o coordenador estava publicando, pela sequência ímpar/par do bloco) e a escreve no
+ * formato de texto do Prometheus. Sem opções escreve uma vez na saída padrão, o que serve para o
+ * coletor de arquivos de texto do node_exporter; com `--http PORTA` atende `GET /metrics` em um
+ * laço, relendo o bloco a cada pedido, para ser raspado diretamente. O bloco é aberto de novo a
+ * cada leitura: um jogo que terminou e começou outra vez com o mesmo nome continua sendo lido.
+ */
+
+struct Fotografia
+{
+    std::uint64_t partidas, rodadas, disputas, rodadas_por_s_mili, fila_registro, instante_ns;
+    std::int64_t jogadores_ativos;
+    std::uint64_t despertar_baldes[BlocoMetricas::NUM_BALDES];
+    std::uint64_t despertar_total, despertar_soma_ns;
+};
+
+// Lê o bloco; false com o motivo em `erro` se não existe, não é da versão esperada ou o
+// publicador não saiu da seção ímpar
+bool fotografar(const std::string &nome, Fotografia &foto, std::string &erro){
+    const int descritor = ::shm_open(Metricas::nome_shm(nome).c_str(), O_RDONLY, 0);
+    if (descritor < 0){
+        erro = std::string("shm_open: ") + std::strerror(errno);
+        return false;
+    }
+    void *mapa = ::mmap(nullptr, sizeof(BlocoMetricas), PROT_READ, MAP_SHARED, descritor, 0);
+    ::close(descritor);
+    if (mapa == MAP_FAILED){
+        erro = std::string("mmap: ") + std::strerror(errno);
+        return false;
+    }
+    const auto *bloco = static_cast<const BlocoMetricas*>(mapa);
+
+    bool lida = false;
+    if (std::memcmp(bloco->magica, MAGICA_METRICAS, sizeof(MAGICA_METRICAS)) != 0 ||
+        bloco->versao != VERSAO_METRICAS || bloco->num_baldes != BlocoMetricas::NUM_BALDES){
+        erro = "bloco de outra versão";
+    } else {
+        for (int tentativa = 0; tentativa < 1000 && !lida; ++tentativa){
+            const std::uint64_t antes = bloco->sequencia.load(std::memory_order_acquire);
+            if (antes % 2 != 0){
+                std::this_thread::yield();
+                continue;
+            }
+            foto.rodadas_por_s_mili = bloco->rodadas_por_s_mili.load(std::memory_order_relaxed);
+            foto.disputas = bloco->disputas.load(std::memory_order_relaxed);
+            foto.fila_registro = bloco->fila_registro.load(std::memory_order_relaxed);
+            foto.instante_ns = bloco->instante_ns.load(std::memory_order_relaxed);
+            for (unsigned i = 0; i < BlocoMetricas::NUM_BALDES; ++i){
+                foto.despertar_baldes[i] = bloco->despertar_baldes[i].load(std::memory_order_relaxed);
+            }
+            foto.despertar_total = bloco->despertar_total.load(std::memory_order_relaxed);
+            foto.despertar_soma_ns = bloco->despertar_soma_ns.load(std::memory_order_relaxed);
+            std::atomic_thread_fence(std::memory_order_acquire);
+            lida = bloco->sequencia.load(std::memory_order_relaxed) == antes;
+        }
+        if (!lida) erro = "publicação em andamento";
+        // Contadores somados a cada rodada: fora da sequência, cada um vale por si
+        foto.partidas = bloco->partidas.load(std::memory_order_relaxed);
+        foto.rodadas = bloco->rodadas.load(std::memory_order_relaxed);
+        foto.jogadores_ativos = bloco->jogadores_ativos.load(std::memory_order_relaxed);
+    }
+    ::munmap(mapa, sizeof(BlocoMetricas));
+    return lida;
+}
+
+void metrica(std::string &saida, const char *nome, const char *tipo, const char *ajuda, double valor){
+    char linha[256];
+    std::snprintf(linha, sizeof(linha), "# HELP %s %s\n# TYPE %s %s\n%s %.10g\n", nome, ajuda, nome, tipo, nome, valor);
+    saida += linha;
+}
+
+std::string formatar(const Fotografia &foto){
+    std::string saida;
+    metrica(saida, "jdc_partidas_total", "counter", "Partidas concluídas.", static_cast<double>(foto.partidas));
+    metrica(saida, "jdc_rodadas_total", "counter", "Rodadas jogadas em todas as partidas.", static_cast<double>(foto.rodadas));
+    metrica(saida, "jdc_rodadas_por_segundo", "gauge", "Rodadas por segundo desde a publicação anterior.",
+            foto.rodadas_por_s_mili / 1000.0);
+    metrica(saida, "jdc_jogadores_ativos", "gauge", "Jogadores ainda na disputa nas partidas em andamento.",
+            static_cast<double>(foto.jogadores_ativos));
+    metrica(saida, "jdc_disputas_total", "counter", "Tentativas de sentar repetidas por contenção.",
+            static_cast<double>(foto.disputas));
+    metrica(saida, "jdc_fila_registro", "gauge", "Mensagens do registro publicadas e ainda não escritas.",
+            static_cast<double>(foto.fila_registro));
+    metrica(saida, "jdc_publicacao_idade_segundos", "gauge", "Tempo desde a última publicação do bloco.",
+            foto.instante_ns ? (agora_ns() - foto.instante_ns) / 1e9 : 0.0);
+
+    saida += "# HELP jdc_despertar_segundos Da parada da música até o jogador acordar.\n"
+             "# TYPE jdc_despertar_segundos histogram\n";
+    char linha[160];
+    for (unsigned i = 0; i < BlocoMetricas::NUM_BALDES; ++i){
+        std::snprintf(linha, sizeof(linha), "jdc_despertar_segundos_bucket{le=\"%.9g\"} %llu\n",
+                      BlocoMetricas::limite_balde(i) / 1e9, static_cast<unsigned long long>(foto.despertar_baldes[i]));
+        saida += linha;
+    }
+    std::snprintf(linha, sizeof(linha),
+                  "jdc_despertar_segundos_bucket{le=\"+Inf\"} %llu\njdc_despertar_segundos_sum %.9g\n"
+                  "jdc_despertar_segundos_count %llu\n",
+                  static_cast<unsigned long long>(foto.despertar_total), foto.despertar_soma_ns / 1e9,
+                  static_cast<unsigned long long>(foto.despertar_total));
+    saida += linha;
+    return saida;
+}
+
+void responder(int conexao, const char *status, const std::string &corpo){
+    const std::string resposta = std::string("HTTP/1.0 ") + status +
+        "\r\nContent-Type: text/plain; version=0.0.4; charset=utf-8\r\nContent-Length: " +
+        std::to_string(corpo.size()) + "\r\nConnection: close\r\n\r\n" + corpo;
+    for (std::size_t enviado = 0; enviado < resposta.size(); ){
+        const ssize_t n = ::send(conexao, resposta.data() + enviado, resposta.size() - enviado, MSG_NOSIGNAL);
+        if (n <= 0) break;
+        enviado += static_cast<std::size_t>(n);
+    }
+}
+
+// Um pedido por vez: uma raspagem a cada poucos segundos não precisa de mais
+int servir(const std::string &nome, int porta){
+    const int servidor = ::socket(AF_INET, SOCK_STREAM, 0);
+    const int sim = 1;
+    ::setsockopt(servidor, SOL_SOCKET, SO_REUSEADDR, &sim, sizeof(sim));
+    sockaddr_in endereco{};
+    endereco.sin_family = AF_INET;
+    endereco.sin_addr.s_addr = htonl(INADDR_ANY);
+    endereco.sin_port = htons(static_cast<std::uint16_t>(porta));
+    if (servidor < 0 || ::bind(servidor, reinterpret_cast<sockaddr*>(&endereco), sizeof(endereco)) != 0 ||
+        ::listen(servidor, 16) != 0){
+        std::cerr << "porta " << porta << ": " << std::strerror(errno) << "\n";
+        return 1;
+    }
+    std::cerr << "Servindo /metrics de /dev/shm" << Metricas::nome_shm(nome) << " na porta " << porta << "\n";
+
+    for (;;){
+        const int conexao = ::accept(servidor, nullptr, nullptr);
+        if (conexao < 0) continue;
+        char pedido[1024];
+        const ssize_t n = ::recv(conexao, pedido, sizeof(pedido) - 1, 0);
+        pedido[n > 0 ? n : 0] = '\0';
+
+        Fotografia foto{};
+        std::string erro;
+        if (std::strncmp(pedido, "GET /metrics", 12) != 0){
+            responder(conexao, "404 Not Found", "use /metrics\n");
+        } else if (!fotografar(nome, foto, erro)){
+            responder(conexao, "503 Service Unavailable", erro + "\n");
+        } else {
+            responder(conexao, "200 OK", formatar(foto));
+        }
+        ::close(conexao);
+    }
+}
+
+int main(int argc, char **argv){
+    std::string nome;
+    long porta = 0;
+    bool valido = true;
+    for (int i = 1; i < argc && valido; ++i){
+        const std::string arg = argv[i];
+        if (arg == "--http" && i + 1 < argc){
+            char *fim = nullptr;
+            porta = std::strtol(argv[++i], &fim, 10);
+            valido = *fim == '\0' && porta >= 1 && porta <= 65535;
+        } else if (nome.empty() && !arg.empty() && arg[0] != '-'){
+            nome = arg;
+        } else {
+            valido = false;
+        }
+    }
+    if (!valido || nome.empty()){
+        std::cerr << "Uso: " << argv[0] << " NOME [--http PORTA]\n"
+                  << "  sem --http, escreve as métricas de /dev/shm/NOME uma vez na saída padrão\n";
+        return 1;
+    }
+
+    if (porta) return servir(nome, static_cast<int>(porta));
+
+    Fotografia foto{};
+    std::string erro;
+    if (!fotografar(nome, foto, erro)){
+        std::cerr << nome << ": " << erro << "\n";
+        return 1;
+    }
+    std::fputs(formatar(foto).c_str(), stdout);
+    return 0;
+}
@@ -0,0 +1,290 @@
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <cerrno>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include "rastro.hpp"
+
+/*
+ * Leitor do rastro binário do Jogo das Cadeiras (`JogoDasCadeiras --rastro ARQUIVO`).
+ *
+ * Mapeia o arquivo em memória e percorre os registros em sequência, sem nenhuma conversão de
+ * texto, validando cada partida:
+ *   - as rodadas são numeradas em sequência e cada uma começa com os ativos que sobraram da anterior;
+ *   - cada jogador ativo tenta sentar exatamente uma vez por rodada, e jogadores eliminados não tentam;
+ *   - nenhuma cadeira é ocupada duas vezes na mesma rodada;
+ *   - uma rodada com C cadeiras tem C jogadores sentados e os demais eliminados;
+ *   - o vencedor é o único jogador que sobrou.
+ *
+ * Com `--exibir`, reconstrói cada rodada em texto (quem sentou em qual cadeira e quem saiu);
+ * `--partida K` restringe a exibição à partida K. Ao final mostra o resumo e a vazão da leitura.
+ */
+
+struct OpcoesReproducao
+{
+    std::string arquivo;
+    bool exibir = false;
+    long partida = -1; // -1: todas
+};
+
+void exibir_uso(const char *programa){
+    std::cerr << "Uso: " << programa << " ARQUIVO [opções]\n"
+              << "  --exibir              reconstrói as rodadas em texto\n"
+              << "  --partida K           exibe só a partida K (a partir de 0)\n";
+}
+
+bool ler_opcoes(int argc, char **argv, OpcoesReproducao &opcoes){
+    for (int i = 1; i < argc; ++i){
+        std::string arg = argv[i];
+        if (arg == "--exibir"){
+            opcoes.exibir = true;
+        } else if (arg == "--partida" && i + 1 < argc){
+            char *fim = nullptr;
+            opcoes.partida = std::strtol(argv[++i], &fim, 10);
+            if (*fim != '\0' || opcoes.partida < 0) return false;
+            opcoes.exibir = true;
+        } else if (opcoes.arquivo.empty() && !arg.empty() && arg[0] != '-'){
+            opcoes.arquivo = arg;
+        } else {
+            return false;
+        }
+    }
+    return !opcoes.arquivo.empty();
+}
+
+// Estado da partida em reconstrução; os vetores são reaproveitados de uma partida para a outra
+class Validador
+{
+public:
+    explicit Validador(const OpcoesReproducao &opcoes)
+        : opcoes(opcoes) {}
+
+    void processar(const EventoRastro &evento, std::uint64_t posicao){
+        this->posicao = posicao;
+        switch (evento.tipo){
+            case TipoEvento::Partida: iniciar_partida(evento); break;
+            case TipoEvento::Rodada: iniciar_rodada(evento); break;
+            case TipoEvento::Sentou:
+            case TipoEvento::Eliminado: tentativa(evento); break;
+            case TipoEvento::Vencedor: encerrar_partida(evento); break;
+            default: falha("tipo de evento desconhecido %u", static_cast<unsigned>(evento.tipo));
+        }
+    }
+
+    // Chamado depois do último evento
+    void concluir(){
+        if (em_partida) falha("partida %u sem evento de vencedor", numero_partida);
+    }
+
+    std::uint64_t get_partidas() const{
+        return partidas;
+    }
+    std::uint64_t get_rodadas() const{
+        return rodadas;
+    }
+    std::uint64_t get_erros() const{
+        return erros;
+    }
+
+private:
+    void iniciar_partida(const EventoRastro &evento){
+        if (em_partida) falha("partida %u sem evento de vencedor", numero_partida);
+        em_partida = true;
+        em_rodada = false;
+        numero_partida = evento.cadeira;
+        num_jogadores = evento.jogador;
+        ativos = num_jogadores;
+        rodada = 0;
+        exibindo = opcoes.exibir && (opcoes.partida < 0 || opcoes.partida == static_cast<long>(numero_partida));
+        partidas++;
+
+        // Rodada em que cada jogador tentou pela última vez; UINT32_MAX = eliminado
+        ultima_tentativa.assign(num_jogadores + 1, 0);
+        std::fill(rodada_da_cadeira.begin(), rodada_da_cadeira.end(), 0);
+        if (exibindo){
+            std::printf("Partida %u com %u jogadores\n", numero_partida, num_jogadores);
+        }
+    }
+
+    void iniciar_rodada(const EventoRastro &evento){
+        if (!em_partida){
+            falha("rodada %u fora de uma partida", evento.rodada);
+            return;
+        }
+        fechar_rodada();
+        if (evento.rodada != rodada + 1) falha("rodada %u depois da rodada %u", evento.rodada, rodada);
+        if (evento.jogador != ativos) falha("rodada %u com %u ativos, mas restavam %u", evento.rodada, evento.jogador, ativos);
+        rodada = evento.rodada;
+        cadeiras = evento.cadeira;
+        ativos_rodada = ativos;
+        tentativas = 0;
+        sentados = 0;
+        em_rodada = true;
+        rodadas++;
+        if (exibindo){
+            std::printf("\nRodada %u: %u jogadores, %u cadeiras\n", rodada, evento.jogador, cadeiras);
+        }
+    }
+
+    void tentativa(const EventoRastro &evento){
+        if (!em_rodada){
+            falha("tentativa do jogador P%u fora de uma rodada", evento.jogador);
+            return;
+        }
+        if (evento.rodada != rodada) falha("tentativa da rodada %u durante a rodada %u", evento.rodada, rodada);
+        const std::uint32_t id = evento.jogador;
+        if (id == 0 || id > num_jogadores){
+            falha("jogador P%u fora da partida", id);
+            return;
+        }
+        if (ultima_tentativa[id] == ELIMINADO){
+            falha("jogador P%u já eliminado tentou sentar", id);
+        } else if (ultima_tentativa[id] == rodada){
+            falha("jogador P%u tentou sentar duas vezes", id);
+        }
+        tentativas++;
+
+        if (evento.tipo == TipoEvento::Sentou){
+            ultima_tentativa[id] = rodada;
+            const std::uint32_t cadeira = evento.cadeira;
+            if (cadeira == 0){
+                falha("jogador P%u sentou na cadeira 0", id);
+            } else {
+                if (cadeira >= rodada_da_cadeira.size()) rodada_da_cadeira.resize(cadeira * 2 + 1, 0);
+                if (rodada_da_cadeira[cadeira] == rodada) falha("cadeira %u ocupada duas vezes", cadeira);
+                rodada_da_cadeira[cadeira] = rodada;
+            }
+            sentados++;
+            if (exibindo) std::printf("[Cadeira %u]: Ocupada por P%u\n", cadeira, id);
+        } else {
+            ultima_tentativa[id] = ELIMINADO;
+            ativos--;
+            if (exibindo) std::printf("Jogador P%u eliminado\n", id);
+        }
+    }
+
+    void encerrar_partida(const EventoRastro &evento){
+        if (!em_partida){
+            falha("vencedor fora de uma partida");
+            return;
+        }
+        fechar_rodada();
+        if (evento.rodada != rodada) falha("vencedor após %u rodadas, mas o rastro tem %u", evento.rodada, rodada);
+        const std::uint32_t vencedor = evento.jogador;
+        if (vencedor != 0){
+            if (ativos != 1) falha("vencedor P%u com %u jogadores restantes", vencedor, ativos);
+            if (vencedor > num_jogadores || ultima_tentativa[vencedor] == ELIMINADO){
+                falha("vencedor P%u foi eliminado", vencedor);
+            }
+        }
+        if (exibindo){
+            if (vencedor) std::printf("\nVencedor: P%u\n\n", vencedor);
+            else std::printf("\nPartida interrompida com %u jogadores\n\n", ativos);
+        }
+        em_partida = false;
+    }
+
+    // Confere a rodada que terminou: todos tentaram e as cadeiras foram todas ocupadas
+    void fechar_rodada(){
+        if (!em_rodada) return;
+        if (tentativas != ativos_rodada) falha("rodada %u com %u tentativas de %u ativos", rodada, tentativas, ativos_rodada);
+        if (sentados != cadeiras) falha("rodada %u com %u sentados em %u cadeiras", rodada, sentados, cadeiras);
+        em_rodada = false;
+    }
+
+    template <typename... Args>
+    void falha(const char *formato, Args... args){
+        if (erros++ < MAX_ERROS_EXIBIDOS){
+            std::fprintf(stderr, "evento %llu (partida %u): ", static_cast<unsigned long long>(posicao), numero_partida);
+            std::fprintf(stderr, formato, args...);
+            std::fputc('\n', stderr);
+        }
+    }
+
+    static constexpr std::uint32_t ELIMINADO = UINT32_MAX;
+    static constexpr std::uint64_t MAX_ERROS_EXIBIDOS = 20;
+
+    const OpcoesReproducao &opcoes;
+    std::vector<std::uint32_t> ultima_tentativa;
+    std::vector<std::uint32_t> rodada_da_cadeira;
+    std::uint64_t posicao = 0;
+    std::uint64_t partidas = 0, rodadas = 0, erros = 0;
+    std::uint32_t numero_partida = 0, num_jogadores = 0, ativos = 0;
+    std::uint32_t rodada = 0, cadeiras = 0, ativos_rodada = 0, tentativas = 0, sentados = 0;
+    bool em_partida = false, em_rodada = false, exibindo = false;
+};
+
+int main(int argc, char **argv){
+    OpcoesReproducao opcoes;
+    if (!ler_opcoes(argc, argv, opcoes)){
+        exibir_uso(argv[0]);
+        return 1;
+    }
+
+    const int descritor = ::open(opcoes.arquivo.c_str(), O_RDONLY);
+    struct stat info{};
+    if (descritor < 0 || ::fstat(descritor, &info) != 0){
+        std::cerr << opcoes.arquivo << ": " << std::strerror(errno) << "\n";
+        return 1;
+    }
+    const std::size_t tamanho = static_cast<std::size_t>(info.st_size);
+    if (tamanho < sizeof(CabecalhoRastro)){
+        std::cerr << opcoes.arquivo << ": arquivo menor que o cabeçalho\n";
+        return 1;
+    }
+
+    void *mapa = ::mmap(nullptr, tamanho, PROT_READ, MAP_PRIVATE, descritor, 0);
+    if (mapa == MAP_FAILED){
+        std::cerr << opcoes.arquivo << ": mmap: " << std::strerror(errno) << "\n";
+        return 1;
+    }
+    // Os conselhos do madvise são códigos, não bits: cada um vai em uma chamada. Só afetam a
+    // leitura antecipada, então uma falha é avisada e a validação continua
+    for (const int conselho : {MADV_SEQUENTIAL, MADV_WILLNEED}){
+        if (::madvise(mapa, tamanho, conselho) != 0){
+            std::cerr << opcoes.arquivo << ": madvise: " << std::strerror(errno) << "\n";
+        }
+    }
+
+    const auto *cabecalho = static_cast<const CabecalhoRastro*>(mapa);
+    if (std::memcmp(cabecalho->magica, MAGICA_RASTRO, sizeof(MAGICA_RASTRO)) != 0 ||
+        cabecalho->versao != VERSAO_RASTRO || cabecalho->tamanho_evento != sizeof(EventoRastro)){
+        std::cerr << opcoes.arquivo << ": não é um rastro da versão " << VERSAO_RASTRO << "\n";
+        return 1;
+    }
+    const std::uint64_t num_eventos = cabecalho->num_eventos;
+    if ((tamanho - sizeof(CabecalhoRastro)) / sizeof(EventoRastro) < num_eventos){
+        std::cerr << opcoes.arquivo << ": truncado (" << num_eventos << " eventos no cabeçalho)\n";
+        return 1;
+    }
+    const auto *eventos = reinterpret_cast<const EventoRastro*>(cabecalho + 1);
+
+    const auto inicio = std::chrono::steady_clock::now();
+    Validador validador(opcoes);
+    for (std::uint64_t i = 0; i < num_eventos; ++i){
+        validador.processar(eventos[i], i);
+    }
+    validador.concluir();
+    const double segundos = std::chrono::duration<double>(std::chrono::steady_clock::now() - inicio).count();
+
+    const double bytes = static_cast<double>(num_eventos * sizeof(EventoRastro));
+    std::fprintf(stderr, "%llu eventos, %llu partidas, %llu rodadas, %llu erros; %.1f MB em %.3f s (%.2f GB/s)\n",
+                 static_cast<unsigned long long>(num_eventos),
+                 static_cast<unsigned long long>(validador.get_partidas()),
+                 static_cast<unsigned long long>(validador.get_rodadas()),
+                 static_cast<unsigned long long>(validador.get_erros()),
+                 bytes / 1e6, segundos, segundos > 0 ? bytes / 1e9 / segundos : 0.0);
+
+    ::munmap(mapa, tamanho);
+    ::close(descritor);
+    return validador.get_erros() == 0 ? 0 : 2;
+}
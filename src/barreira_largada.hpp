@@ -0,0 +1,53 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <thread>
+
+#include "relogio.hpp"
+
+/*
+ * Barreira de largada (`--largada`): segura cada jogador que acordou com a parada da música até
+ * o último jogador ativo da rodada chegar e então solta todos ao mesmo tempo.
+ *
+ * Sem ela, quem acorda primeiro de `music_cv.notify_all()` (um por vez, sob `music_mutex`) ou do
+ * sinal atômico já disputa as cadeiras enquanto os outros ainda estão acordando, e a "disputa" é
+ * decidida pela ordem em que o kernel acorda as threads. Com a barreira, todas as tentativas
+ * começam juntas e as estratégias de cadeiras são medidas sob contenção de verdade.
+ *
+ * Os jogadores esperam girando em uma geração (sem syscalls, para que saiam juntos); depois de
+ * muitas voltas passam a ceder a CPU. Com mais jogadores que núcleos, girar só atrasaria quem
+ * ainda não chegou, e a espera cede a CPU desde a primeira volta. A barreira se reinicia
+ * sozinha: o último a chegar zera as chegadas antes de abrir a geração.
+ */
+class BarreiraLargada
+{
+public:
+    explicit BarreiraLargada(unsigned num_cpus)
+        : num_cpus(num_cpus) {}
+
+    // Bloqueia até `participantes` chamadas desta rodada; todas retornam ao mesmo tempo
+    void aguardar(int participantes){
+        const std::uint32_t vista = geracao.load(std::memory_order_acquire);
+        if (chegadas.fetch_add(1, std::memory_order_acq_rel) + 1 >= participantes){
+            chegadas.store(0, std::memory_order_relaxed);
+            geracao.store(vista + 1, std::memory_order_release);
+            return;
+        }
+        const unsigned girando = static_cast<unsigned>(participantes) <= num_cpus ? VOLTAS_GIRANDO : 0;
+        for (unsigned voltas = 0; geracao.load(std::memory_order_acquire) == vista; ++voltas){
+            if (voltas < girando){
+                pausar();
+            } else {
+                std::this_thread::yield();
+            }
+        }
+    }
+
+private:
+    static constexpr unsigned VOLTAS_GIRANDO = 4096;
+
+    unsigned num_cpus;
+    alignas(64) std::atomic<int> chegadas{0};
+    alignas(64) std::atomic<std::uint32_t> geracao{0};
+};
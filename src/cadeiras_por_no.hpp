@@ -0,0 +1,64 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <memory_resource>
+#include <vector>
+
+#include "contador_cadeiras.hpp"
+#include "disputas.hpp"
+
+/*
+ * Cadeiras fragmentadas por nó NUMA.
+ *
+ * As cadeiras da rodada são divididas entre os nós, cada fragmento com seu próprio
+ * `ContadorCadeiras` em uma linha de cache separada. O jogador pede primeiro uma senha no
+ * fragmento do nó em que está rodando e só tenta os fragmentos remotos, em ordem, quando o local
+ * acabou. Como cada fragmento só distribui a sua capacidade, a soma continua exata: um jogador só
+ * é eliminado depois de encontrar todos os fragmentos esgotados.
+ */
+class CadeirasPorNo
+{
+public:
+    CadeirasPorNo(std::uint32_t cadeiras, unsigned num_nos,
+                  std::pmr::memory_resource *recurso = std::pmr::get_default_resource())
+        : num_nos(num_nos == 0 ? 1 : num_nos),
+          fragmentos(this->num_nos, recurso){
+        nova_rodada(cadeiras);
+    }
+
+    // Retorna o índice global da cadeira (a partir de 0) ou -1 se todas acabaram
+    std::int64_t ocupar(unsigned no_local){
+        no_local %= num_nos;
+        for (unsigned k = 0; k < num_nos; ++k){
+            Fragmento &fragmento = fragmentos[(no_local + k) % num_nos];
+            const std::int64_t indice = fragmento.contador.ocupar();
+            if (indice >= 0){
+                if (k > 0) Disputas::instancia().registrar(); // cadeira de outro nó
+                return static_cast<std::int64_t>(fragmento.inicio) + indice;
+            }
+        }
+        return -1;
+    }
+
+    // Divide as cadeiras igualmente entre os nós (os primeiros ficam com o resto)
+    void nova_rodada(std::uint32_t cadeiras){
+        std::uint32_t inicio = 0;
+        for (unsigned no = 0; no < num_nos; ++no){
+            const std::uint32_t capacidade = cadeiras / num_nos + (no < cadeiras % num_nos ? 1 : 0);
+            fragmentos[no].inicio = inicio;
+            fragmentos[no].contador.nova_rodada(capacidade);
+            inicio += capacidade;
+        }
+    }
+
+private:
+    struct alignas(64) Fragmento
+    {
+        ContadorCadeiras contador{0};
+        std::uint32_t inicio = 0; // só muda entre rodadas
+    };
+
+    unsigned num_nos;
+    std::pmr::vector<Fragmento> fragmentos;
+};
@@ -0,0 +1,81 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+
+// Configuração de uma partida (lida da linha de comando pelo jogo ou montada pelo benchmark)
+enum class ModoExecucao
+{
+    Threads,  // uma std::thread por jogador
+    Pool,     // jogadores como tarefas em um pool fixo de threads
+    Corrotina // uma corrotina por jogador, retomada pelo coordenador ou pelo pool
+};
+
+enum class TipoSinal
+{
+    VariavelCondicao, // music_cv + music_mutex
+    Atomico,          // contador de geração com std::atomic::wait (SinalMusica)
+    Adaptativo        // como Atomico, mas gira antes de estacionar se a música deve parar logo (EsperaAdaptativa)
+};
+
+enum class EstrategiaCadeiras
+{
+    Semaforo, // std::counting_semaphore, drenado e reabastecido a cada rodada
+    Contador, // ContadorCadeiras: um fetch_add por jogador, um store por rodada
+    Vetor,    // VetorCadeiras: uma cadeira por slot, ocupada com CAS, registra quem sentou
+    PorNo,    // CadeirasPorNo: um contador por nó NUMA, o jogador tenta o do próprio nó primeiro
+    Hierarquico // ContadorHierarquico: reservas por thread reabastecidas em lotes de uma global
+};
+
+// Quantas cadeiras cada rodada tem: o jogo original remove uma por rodada (N-1 rodadas); removendo
+// uma quantidade fixa ou uma porcentagem dos ativos, várias eliminações acontecem na mesma rodada
+struct RemocaoCadeiras
+{
+    int quantidade = 1; // cadeiras a menos que jogadores ativos
+    int percentual = 0; // > 0: remove ceil(ativos * percentual / 100) e ignora `quantidade`
+
+    // Sempre elimina ao menos um jogador e deixa ao menos uma cadeira enquanto houver disputa
+    int cadeiras_para(int ativos) const{
+        if (ativos < 2) return 0;
+        std::int64_t remover = quantidade;
+        if (percentual > 0){
+            remover = (static_cast<std::int64_t>(ativos) * percentual + 99) / 100;
+        }
+        if (remover < 1) remover = 1;
+        if (remover > ativos - 1) remover = ativos - 1;
+        return static_cast<int>(ativos - remover);
+    }
+};
+
+struct Configuracao
+{
+    int num_jogadores = 4;
+    ModoExecucao modo = ModoExecucao::Threads;
+    TipoSinal sinal = TipoSinal::VariavelCondicao;
+    EstrategiaCadeiras estrategia = EstrategiaCadeiras::Semaforo;
+    bool silencioso = false;
+
+    // Tempo da música e pausa extra depois que todos tentaram sentar (só para acompanhar a
+    // saída); no modo simulado o tempo é virtual
+    int musica_min_ms = 1000;
+    int musica_max_ms = 3000;
+    int espera_ms = 0;
+    bool simulado = false;
+    bool tem_semente = false;
+    std::uint64_t semente = 0;
+
+    bool fixar_cpus = false;  // fixa jogadores, trabalhadoras e coordenador em núcleos, nó a nó
+    unsigned num_threads = 0; // threads do pool; 0 = hardware_concurrency() (corrotina: 0 ou 1 = sem pool)
+    int max_rodadas = 0;      // encerra a partida sem vencedor após tantas rodadas; 0 = sem limite
+    bool coletar_estatisticas = false; // guarda as latências de cada rodada (benchmark)
+    RemocaoCadeiras remocao;
+    bool instrumentar = false;  // histogramas de latência por thread (Instrumentacao)
+    int jogadores_por_mesa = 0; // > 0: torneio em mesas deste tamanho (Torneio)
+    int partidas = 1;           // partidas seguidas no mesmo ContextoPartida
+    bool largada = false;       // modo threads: BarreiraLargada solta os jogadores da rodada juntos
+    bool inicio_rapido = false; // prepara arena e threads antes da partida, criando as threads em paralelo
+    std::string arquivo_rastro; // não vazio: grava os eventos das partidas neste arquivo (Rastro)
+    std::string nome_metricas;  // não vazio: publica métricas ao vivo em /dev/shm/NOME (Metricas)
+    std::string nos_distribuidos; // não vazio: joga com os jogadores nos nós "HOST:PORTA,..." (CoordenadorDistribuido)
+    int porta_no = 0;             // > 0: serve fragmentos de jogadores nesta porta UDP (NoJogadores)
+};
@@ -0,0 +1,45 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+
+/*
+ * Alocador de cadeiras por senha (fetch_add), alternativa ao `counting_semaphore`.
+ *
+ * Uma única palavra de 64 bits guarda a capacidade da rodada (32 bits altos) e o número de
+ * senhas já distribuídas (32 bits baixos). Sentar custa um único `fetch_add`: quem recebe uma
+ * senha menor que a capacidade ganha a cadeira com esse número. Reiniciar a rodada é um único
+ * `store` com a nova capacidade, sem drenar permissões uma a uma como no semáforo.
+ */
+class ContadorCadeiras
+{
+public:
+    explicit ContadorCadeiras(std::uint32_t cadeiras)
+        : estado(compor(cadeiras)) {}
+
+    // Retorna o índice da cadeira obtida (a partir de 0) ou -1 se não sobrou cadeira
+    std::int64_t ocupar(){
+        std::uint64_t anterior = estado.fetch_add(1, std::memory_order_acq_rel);
+        std::uint32_t senha = static_cast<std::uint32_t>(anterior);
+        std::uint32_t capacidade = static_cast<std::uint32_t>(anterior >> 32);
+        return senha < capacidade ? static_cast<std::int64_t>(senha) : -1;
+    }
+
+    void nova_rodada(std::uint32_t cadeiras){
+        estado.store(compor(cadeiras), std::memory_order_release);
+    }
+
+    std::uint32_t ocupadas() const{
+        std::uint64_t atual = estado.load(std::memory_order_acquire);
+        std::uint32_t senhas = static_cast<std::uint32_t>(atual);
+        std::uint32_t capacidade = static_cast<std::uint32_t>(atual >> 32);
+        return senhas < capacidade ? senhas : capacidade;
+    }
+
+private:
+    static std::uint64_t compor(std::uint32_t cadeiras){
+        return static_cast<std::uint64_t>(cadeiras) << 32;
+    }
+
+    alignas(64) std::atomic<std::uint64_t> estado;
+};
@@ -0,0 +1,124 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <memory_resource>
+#include <thread>
+#include <vector>
+
+#include "disputas.hpp"
+
+/*
+ * Contador de cadeiras hierárquico: reservas locais reabastecidas em lotes de uma reserva global.
+ *
+ * Com um único contador (semáforo ou `ContadorCadeiras`) toda tentativa de sentar é um RMW na
+ * mesma linha de cache. Aqui cada thread usa um fragmento (escolhido em rodízio na primeira vez)
+ * com a sua própria reserva de permissões; quando ela acaba, a thread tira um lote inteiro da
+ * reserva global com um `fetch_sub` e o deposita no fragmento. A maior parte das tentativas só
+ * toca a linha do próprio fragmento.
+ *
+ * O total continua exatamente `cadeiras`: a reserva global só perde o que foi depositado em algum
+ * fragmento, e um jogador só é eliminado depois de a reserva global estar vazia e de ele não
+ * encontrar permissão em nenhum fragmento. Para que um lote retirado da global e ainda não
+ * depositado não escape dessa verificação, quem reabastece conta o lote em `em_transito` antes de
+ * retirá-lo, e cada depósito incrementa `depositos`: a verificação só vale se não havia nada em
+ * trânsito e nenhum depósito aconteceu durante a varredura.
+ *
+ * Não há um número global de cadeira: a cadeira é identificada pelo fragmento `f` e pela ordem `j`
+ * em que foi ocupada nele, como `f + j * num_fragmentos` (única, mas não contígua).
+ */
+class ContadorHierarquico
+{
+public:
+    explicit ContadorHierarquico(std::uint32_t cadeiras,
+                                 unsigned num_fragmentos = std::min(64u, std::max(1u, std::thread::hardware_concurrency())),
+                                 std::pmr::memory_resource *recurso = std::pmr::get_default_resource())
+        : num_fragmentos(num_fragmentos == 0 ? 1 : num_fragmentos),
+          fragmentos(this->num_fragmentos, recurso){
+        nova_rodada(cadeiras);
+    }
+
+    // Retorna o identificador da cadeira obtida (a partir de 0) ou -1 se não sobrou cadeira
+    std::int64_t ocupar(){
+        const unsigned proprio = fragmento_da_thread() % num_fragmentos;
+
+        for (;;){
+            if (std::int64_t cadeira = retirar(proprio); cadeira >= 0) return cadeira;
+            if (!reabastecer(proprio)) break;
+        }
+
+        // Reserva global vazia: sobra procurar nos outros fragmentos
+        for (;;){
+            const std::uint64_t vistos = depositos.load(std::memory_order_seq_cst);
+            for (unsigned k = 1; k <= num_fragmentos; ++k){
+                const unsigned indice = (proprio + k) % num_fragmentos;
+                if (std::int64_t cadeira = retirar(indice); cadeira >= 0){
+                    if (indice != proprio) Disputas::instancia().registrar(); // emprestada de outra thread
+                    return cadeira;
+                }
+            }
+            if (em_transito.load(std::memory_order_seq_cst) == 0 &&
+                depositos.load(std::memory_order_seq_cst) == vistos){
+                return -1;
+            }
+            std::this_thread::yield(); // um lote está a caminho de algum fragmento
+        }
+    }
+
+    // Chamado entre rodadas, sem ninguém tentando sentar
+    void nova_rodada(std::uint32_t cadeiras){
+        lote = std::max<std::int64_t>(1, std::min<std::int64_t>(64, cadeiras / (4 * num_fragmentos)));
+        for (unsigned i = 0; i < num_fragmentos; ++i){
+            fragmentos[i].estado.store(0, std::memory_order_relaxed);
+        }
+        global.store(cadeiras, std::memory_order_seq_cst);
+    }
+
+private:
+    // Estado de um fragmento: permissões disponíveis (32 bits baixos) e cadeiras já ocupadas
+    // nesta rodada (32 bits altos), alteradas juntas por CAS
+    struct alignas(64) Fragmento
+    {
+        std::atomic<std::uint64_t> estado{0};
+    };
+
+    static unsigned fragmento_da_thread(){
+        static std::atomic<unsigned> proximo{0};
+        static thread_local const unsigned indice = proximo.fetch_add(1, std::memory_order_relaxed);
+        return indice;
+    }
+
+    std::int64_t retirar(unsigned indice){
+        auto &estado = fragmentos[indice].estado;
+        std::uint64_t atual = estado.load(std::memory_order_acquire);
+        while (static_cast<std::uint32_t>(atual) != 0){
+            const std::uint64_t novo = atual - 1 + (std::uint64_t{1} << 32);
+            if (estado.compare_exchange_weak(atual, novo, std::memory_order_acq_rel, std::memory_order_acquire)){
+                const std::uint64_t ordem = atual >> 32;
+                return static_cast<std::int64_t>(indice + ordem * num_fragmentos);
+            }
+        }
+        return -1;
+    }
+
+    // Move um lote da reserva global para o fragmento; false se a global já estava vazia
+    bool reabastecer(unsigned indice){
+        em_transito.fetch_add(lote, std::memory_order_seq_cst);
+        const std::int64_t antes = global.fetch_sub(lote, std::memory_order_seq_cst);
+        const std::int64_t obtidas = std::clamp<std::int64_t>(antes, 0, lote);
+        if (obtidas > 0){
+            fragmentos[indice].estado.fetch_add(static_cast<std::uint64_t>(obtidas), std::memory_order_seq_cst);
+            depositos.fetch_add(1, std::memory_order_seq_cst);
+        }
+        em_transito.fetch_sub(lote, std::memory_order_seq_cst);
+        return obtidas > 0;
+    }
+
+    unsigned num_fragmentos;
+    std::pmr::vector<Fragmento> fragmentos;
+    std::int64_t lote = 1; // só muda entre rodadas
+    alignas(64) std::atomic<std::int64_t> global{0};
+    alignas(64) std::atomic<std::int64_t> em_transito{0};
+    alignas(64) std::atomic<std::uint64_t> depositos{0};
+};
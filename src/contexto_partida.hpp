@@ -0,0 +1,177 @@
+#pragma once
+
+#include <sys/mman.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <memory_resource>
+
+#include "configuracao.hpp"
+#include "jogo.hpp"
+#include "pool_trabalho.hpp"
+#include "threads_estacionadas.hpp"
+
+/*
+ * Contexto reutilizável para partidas curtas em sequência (torneio, benchmark, `--partidas`).
+ *
+ * Cada partida aloca o jogo, a tabela de jogadores, os jogadores, as cadeiras, o índice de
+ * ativos e os quadros das corrotinas em uma `std::pmr::monotonic_buffer_resource` montada sobre
+ * um buffer que pertence ao contexto. Ao fim da partida a arena é descartada de uma vez, sem
+ * desalocações individuais, e a próxima partida reaproveita o mesmo buffer.
+ *
+ * Se uma partida precisar de mais memória que o buffer, o excedente vem do heap (e é contado);
+ * depois dela o buffer cresce para caber a partida inteira. Em regime, partidas do mesmo tamanho
+ * não fazem nenhuma alocação no heap.
+ *
+ * As threads também ficam entre partidas: o pool de threads é mantido enquanto o número de
+ * threads não mudar, e o coordenador e as threads dos jogadores do modo threads são
+ * `ThreadsEstacionadas`, acordadas a cada partida em vez de criadas e juntadas. Partidas seguidas
+ * ficam limitadas pela lógica do jogo, não pela criação de threads do sistema operacional.
+ *
+ * A primeira partida ainda paga tudo isso. Com `config.inicio_rapido`, antes dela o buffer já é
+ * alocado com o tamanho estimado para a partida e as suas páginas tocadas (as faltas de página
+ * acontecem aqui, não nas primeiras alocações nem na primeira rodada), e as threads do modo
+ * threads são criadas em paralelo (`ThreadsEstacionadas::reservar`). O tempo de preparo entra
+ * em `ate_primeira_rodada_ns`.
+ */
+class ContextoPartida
+{
+public:
+    explicit ContextoPartida(std::size_t bytes_iniciais = 64 * 1024)
+        : tamanho(bytes_iniciais), buffer(std::make_unique<std::byte[]>(bytes_iniciais)), memoria(buffer.get()) {}
+
+    ContextoPartida(const ContextoPartida&) = delete;
+    ContextoPartida& operator=(const ContextoPartida&) = delete;
+
+    const ResultadoPartida& executar(const Configuracao &config, Rastro *rastro = nullptr){
+        const std::uint64_t inicio = agora_ns();
+        if (config.inicio_rapido) preparar(config);
+        const std::uint64_t preparo = agora_ns() - inicio;
+
+        excedente.zerar();
+        {
+            std::pmr::monotonic_buffer_resource arena(memoria, tamanho, &excedente);
+            executar_partida(config, &arena, pool_para(config), resultado, &estacionadas, rastro);
+        }
+        resultado.ate_primeira_rodada_ns += preparo;
+
+        // A arena pediu memória ao heap: cresce o buffer para que a próxima partida caiba nele
+        if (excedente.get_bytes() > 0){
+            tamanho = (tamanho + excedente.get_bytes()) * 2;
+            buffer = std::make_unique<std::byte[]>(tamanho);
+            memoria = buffer.get();
+            crescimentos++;
+        }
+        return resultado;
+    }
+
+    std::size_t capacidade() const{
+        return tamanho;
+    }
+
+    // Quantas vezes o buffer precisou crescer desde a criação do contexto
+    std::size_t get_crescimentos() const{
+        return crescimentos;
+    }
+
+    // Threads de coordenador e jogadores criadas desde a criação do contexto
+    std::size_t get_threads_criadas() const{
+        return estacionadas.get_criadas();
+    }
+
+private:
+    // Recurso a montante da arena: repassa ao heap e conta quanto foi pedido
+    class Excedente : public std::pmr::memory_resource
+    {
+    public:
+        void zerar(){
+            bytes = 0;
+        }
+        std::size_t get_bytes() const{
+            return bytes;
+        }
+
+    private:
+        void* do_allocate(std::size_t n, std::size_t alinhamento) override{
+            bytes += n;
+            return std::pmr::new_delete_resource()->allocate(n, alinhamento);
+        }
+        void do_deallocate(void *p, std::size_t n, std::size_t alinhamento) override{
+            std::pmr::new_delete_resource()->deallocate(p, n, alinhamento);
+        }
+        bool do_is_equal(const std::pmr::memory_resource &outro) const noexcept override{
+            return this == &outro;
+        }
+
+        std::size_t bytes = 0;
+    };
+
+    // Bytes por jogador que a arena de uma partida usa, medidos com as políticas atuais e com
+    // folga; se a estimativa ficar curta, o excedente vem do heap e o buffer cresce como sempre
+    static constexpr std::size_t BYTES_POR_JOGADOR = 80;
+    static constexpr std::size_t BYTES_POR_QUADRO = 160;  // quadro de uma corrotina de jogador
+    static constexpr std::size_t BYTES_POR_ASSENTO = 80;  // slot e registro do VetorCadeiras
+    static constexpr std::size_t TAMANHO_PAGINA = 4096;
+    static constexpr std::size_t TAMANHO_PAGINA_ENORME = 2 * 1024 * 1024;
+
+    static std::size_t bytes_estimados(const Configuracao &config){
+        std::size_t por_jogador = BYTES_POR_JOGADOR;
+        if (config.modo == ModoExecucao::Corrotina && !config.simulado) por_jogador += BYTES_POR_QUADRO;
+        if (config.estrategia == EstrategiaCadeiras::Vetor) por_jogador += BYTES_POR_ASSENTO;
+        return static_cast<std::size_t>(config.num_jogadores) * por_jogador;
+    }
+
+    void preparar(const Configuracao &config){
+        const std::size_t estimado = bytes_estimados(config);
+        if (tamanho < estimado){
+            tamanho = estimado;
+            // Alinhado a 2 MB e marcado para páginas enormes (THP em modo `madvise`): uma falta
+            // de página a cada 2 MB em vez de uma a cada 4 KB
+            buffer = std::make_unique_for_overwrite<std::byte[]>(tamanho + TAMANHO_PAGINA_ENORME);
+            const auto endereco = reinterpret_cast<std::uintptr_t>(buffer.get());
+            memoria = buffer.get() + ((TAMANHO_PAGINA_ENORME - endereco % TAMANHO_PAGINA_ENORME) % TAMANHO_PAGINA_ENORME);
+#ifdef MADV_HUGEPAGE
+            ::madvise(memoria, tamanho, MADV_HUGEPAGE); // só um conselho: sem THP, seguem páginas de 4 KB
+#endif
+            // Uma escrita por página basta: o kernel entrega a página já zerada na falta de página,
+            // que acontece aqui e não quando a partida usar a memória
+            volatile std::byte *paginas = memoria;
+            for (std::size_t i = 0; i < tamanho; i += TAMANHO_PAGINA){
+                paginas[i] = std::byte{0};
+            }
+        }
+        if (config.modo == ModoExecucao::Threads && !config.simulado){
+            estacionadas.reservar(static_cast<std::size_t>(config.num_jogadores) + 1, config.fixar_cpus);
+        }
+    }
+
+    // Mantém o pool entre partidas enquanto o número de threads não mudar
+    PoolDeTrabalho* pool_para(const Configuracao &config){
+        if (config.simulado) return nullptr;
+        unsigned threads = 0;
+        if (config.modo == ModoExecucao::Pool){
+            threads = config.num_threads ? config.num_threads : std::thread::hardware_concurrency();
+        } else if (config.modo == ModoExecucao::Corrotina && config.num_threads > 1){
+            threads = config.num_threads;
+        }
+        if (threads == 0) return nullptr;
+
+        if (!pool || pool->tamanho() != threads || pool_fixado != config.fixar_cpus){
+            pool.reset();
+            pool = std::make_unique<PoolDeTrabalho>(threads, config.fixar_cpus);
+            pool_fixado = config.fixar_cpus;
+        }
+        return pool.get();
+    }
+
+    std::size_t tamanho;
+    std::unique_ptr<std::byte[]> buffer;
+    std::byte *memoria; // início da arena dentro de `buffer` (alinhado no início rápido)
+    Excedente excedente;
+    ResultadoPartida resultado{};
+    std::unique_ptr<PoolDeTrabalho> pool;
+    bool pool_fixado = false;
+    ThreadsEstacionadas estacionadas;
+    std::size_t crescimentos = 0;
+};
@@ -0,0 +1,112 @@
+#pragma once
+
+#include <coroutine>
+#include <cstddef>
+#include <exception>
+#include <memory_resource>
+#include <utility>
+
+/*
+ * Corrotina de um jogador (modo "corrotina").
+ *
+ * Em vez de uma thread bloqueada em `music_cv`, cada jogador é um quadro de corrotina de poucas
+ * dezenas de bytes suspenso em `co_await` até a música parar. O coordenador (ou as trabalhadoras
+ * do pool) retoma as corrotinas dos jogadores ativos; cada uma tenta sentar e volta a se suspender
+ * antes de `retomar()` retornar, então a rodada termina quando todas as retomadas terminam.
+ *
+ * A corrotina começa suspensa e também se suspende ao terminar, para que o quadro só seja
+ * destruído pelo dono (esta classe), inclusive o do vencedor, que nunca chega ao fim do laço.
+ *
+ * Os quadros são alocados no recurso de `RecursoDosQuadros` ativo na thread que cria a corrotina
+ * (a arena da partida, em `ContextoPartida`); cada quadro guarda o recurso de onde veio.
+ */
+class CorrotinaJogador
+{
+public:
+    // Enquanto existir, as corrotinas criadas nesta thread alocam seus quadros em `recurso`
+    class RecursoDosQuadros
+    {
+    public:
+        explicit RecursoDosQuadros(std::pmr::memory_resource *recurso)
+            : anterior(std::exchange(atual, recurso)) {}
+        ~RecursoDosQuadros(){
+            atual = anterior;
+        }
+        RecursoDosQuadros(const RecursoDosQuadros&) = delete;
+        RecursoDosQuadros& operator=(const RecursoDosQuadros&) = delete;
+
+    private:
+        friend class CorrotinaJogador;
+        static inline thread_local std::pmr::memory_resource *atual = nullptr;
+        std::pmr::memory_resource *anterior;
+    };
+
+    struct promise_type
+    {
+        static constexpr std::size_t CABECALHO = alignof(std::max_align_t);
+
+        static void* operator new(std::size_t tamanho){
+            std::pmr::memory_resource *recurso = RecursoDosQuadros::atual ? RecursoDosQuadros::atual
+                                                                         : std::pmr::new_delete_resource();
+            void *bloco = recurso->allocate(tamanho + CABECALHO, alignof(std::max_align_t));
+            *static_cast<std::pmr::memory_resource**>(bloco) = recurso;
+            return static_cast<std::byte*>(bloco) + CABECALHO;
+        }
+
+        static void operator delete(void *quadro, std::size_t tamanho){
+            std::byte *bloco = static_cast<std::byte*>(quadro) - CABECALHO;
+            std::pmr::memory_resource *recurso = *reinterpret_cast<std::pmr::memory_resource**>(bloco);
+            recurso->deallocate(bloco, tamanho + CABECALHO, alignof(std::max_align_t));
+        }
+
+        CorrotinaJogador get_return_object(){
+            return CorrotinaJogador(std::coroutine_handle<promise_type>::from_promise(*this));
+        }
+        std::suspend_always initial_suspend() noexcept { return {}; }
+        std::suspend_always final_suspend() noexcept { return {}; }
+        void return_void() {}
+        void unhandled_exception() { std::terminate(); }
+    };
+
+    CorrotinaJogador(CorrotinaJogador &&outra) noexcept
+        : handle(std::exchange(outra.handle, nullptr)) {}
+
+    CorrotinaJogador& operator=(CorrotinaJogador &&outra) noexcept{
+        if (this != &outra){
+            destruir();
+            handle = std::exchange(outra.handle, nullptr);
+        }
+        return *this;
+    }
+
+    CorrotinaJogador(const CorrotinaJogador&) = delete;
+    CorrotinaJogador& operator=(const CorrotinaJogador&) = delete;
+
+    ~CorrotinaJogador(){
+        destruir();
+    }
+
+    // Executa a corrotina até a próxima suspensão (ou até o fim)
+    void retomar(){
+        if (handle && !handle.done()){
+            handle.resume();
+        }
+    }
+
+    bool terminou() const{
+        return !handle || handle.done();
+    }
+
+private:
+    explicit CorrotinaJogador(std::coroutine_handle<promise_type> handle)
+        : handle(handle) {}
+
+    void destruir(){
+        if (handle){
+            handle.destroy();
+            handle = nullptr;
+        }
+    }
+
+    std::coroutine_handle<promise_type> handle;
+};
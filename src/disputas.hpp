@@ -0,0 +1,90 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+/*
+ * Tentativas de sentar repetidas por contenção, contadas por thread: CAS perdidos no
+ * `VetorCadeiras`, cadeiras obtidas em outro nó (`CadeirasPorNo`) ou no fragmento de outra thread
+ * (`ContadorHierarquico`).
+ *
+ * Essas contagens acontecem justamente quando várias threads disputam a mesma cadeira; um
+ * `fetch_add` num contador compartilhado acrescentaria mais uma linha de cache disputada ao
+ * caminho que está sendo medido. Como na `Instrumentacao`, cada thread recebe na primeira disputa
+ * um contador numa linha de cache só sua, que só ela escreve (sem RMW), e o bloco volta a ficar
+ * livre, com a contagem, quando a thread termina. O total é a soma de todos os blocos, calculada
+ * pelo coordenador quando publica as métricas; ele só cresce.
+ */
+class Disputas
+{
+public:
+    static Disputas& instancia(){
+        static Disputas disputas;
+        return disputas;
+    }
+
+    Disputas(const Disputas&) = delete;
+    Disputas& operator=(const Disputas&) = delete;
+
+    // Caminho da disputa: só a thread dona escreve no seu contador
+    void registrar(){
+        auto &c = bloco_da_thread().contagem;
+        c.store(c.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+    }
+
+    // Disputas de todas as threads desde o início do processo
+    std::uint64_t total() const{
+        std::uint64_t soma = 0;
+        std::lock_guard<std::mutex> lock(blocos_mutex);
+        for (auto &bloco : blocos){
+            soma += bloco->contagem.load(std::memory_order_relaxed);
+        }
+        return soma;
+    }
+
+private:
+    struct alignas(64) Bloco
+    {
+        std::atomic<std::uint64_t> contagem{0};
+        bool livre = false; // protegido por blocos_mutex
+    };
+
+    // Devolve o bloco para reuso quando a thread termina
+    struct Vinculo
+    {
+        Bloco *bloco = nullptr;
+        ~Vinculo(){
+            if (bloco){
+                std::lock_guard<std::mutex> lock(instancia().blocos_mutex);
+                bloco->livre = true;
+            }
+        }
+    };
+
+    Disputas() = default;
+
+    Bloco& bloco_da_thread(){
+        static thread_local Vinculo vinculo;
+        if (!vinculo.bloco){
+            std::lock_guard<std::mutex> lock(blocos_mutex);
+            for (auto &bloco : blocos){
+                if (bloco->livre){
+                    bloco->livre = false;
+                    vinculo.bloco = bloco.get();
+                    break;
+                }
+            }
+            if (!vinculo.bloco){
+                blocos.push_back(std::make_unique<Bloco>());
+                vinculo.bloco = blocos.back().get();
+            }
+        }
+        return *vinculo.bloco;
+    }
+
+    mutable std::mutex blocos_mutex;
+    std::vector<std::unique_ptr<Bloco>> blocos;
+};
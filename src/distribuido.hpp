@@ -0,0 +1,521 @@
+#pragma once
+
+#include <arpa/inet.h>
+#include <netdb.h>
+#include <netinet/in.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <chrono>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <memory>
+#include <random>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "configuracao.hpp"
+#include "indice_ativos.hpp"
+#include "jogo.hpp"
+#include "politicas_cadeiras.hpp"
+#include "pool_trabalho.hpp"
+#include "registro.hpp"
+#include "resultado.hpp"
+
+/*
+ * Modo distribuído: os jogadores de uma partida são divididos em fragmentos, cada um em um nó
+ * (`JogoDasCadeiras --no PORTA`), e um coordenador (`JogoDasCadeiras N --nos HOST:PORTA,...`)
+ * conduz as rodadas por UDP. É a mesma divisão entre `Coordenador` e `Jogador`, com um nó no
+ * lugar de cada grupo de jogadores.
+ *
+ * As cadeiras de cada rodada são repartidas em cotas por nó: o coordenador sorteia quais nós
+ * perdem as cadeiras removidas, cada eliminação em um nó com chance proporcional aos seus ativos
+ * (o mesmo que sortear o eliminado entre todos os jogadores). A parada da música leva a cota do
+ * nó, os ativos do fragmento disputam as cadeiras dela na política local (`--cadeiras`) e o nó
+ * responde com quantos sobraram e, se sobrou um, quem é. Cada rodada custa uma mensagem de ida
+ * e uma de volta por nó, qualquer que seja o número de jogadores.
+ *
+ * O UDP pode perder ou duplicar mensagens: o coordenador reenvia a quem ainda não respondeu e o
+ * nó guarda a resposta da última rodada para reenviá-la sem disputar de novo. As mensagens vão na
+ * ordem de bytes da máquina: coordenador e nós devem ser da mesma arquitetura.
+ */
+enum class TipoMensagem : std::uint32_t
+{
+    Iniciar = 1, // coordenador -> nó: fragmento [primeiro_id, primeiro_id + jogadores) e semente
+    Pronto,      // nó -> coordenador
+    Parada,      // coordenador -> nó: a música parou, `cadeiras` é a cota do nó na rodada
+    Resultado,   // nó -> coordenador: `jogadores` ativos depois da rodada e o `vencedor` se sobrou um
+    Fim,         // coordenador -> nó: partida encerrada com `vencedor` (0 = interrompida)
+    Encerrado    // nó -> coordenador
+};
+
+struct MensagemRede
+{
+    char magica[4];          // "JDCR"
+    TipoMensagem tipo;
+    std::uint32_t partida;   // sorteada pelo coordenador: um nó distingue partidas seguidas
+    std::uint32_t rodada;
+    std::uint32_t no;        // índice do nó na lista do coordenador, devolvido nas respostas
+    std::uint32_t primeiro_id;
+    std::uint32_t jogadores;
+    std::uint32_t cadeiras;
+    std::uint32_t vencedor;
+    std::uint32_t reservado;
+    std::uint64_t semente;
+};
+static_assert(sizeof(MensagemRede) == 48 && std::is_trivially_copyable_v<MensagemRede>);
+
+inline MensagemRede nova_mensagem(TipoMensagem tipo, std::uint32_t partida, std::uint32_t rodada, std::uint32_t no){
+    MensagemRede mensagem{};
+    std::memcpy(mensagem.magica, "JDCR", 4);
+    mensagem.tipo = tipo;
+    mensagem.partida = partida;
+    mensagem.rodada = rodada;
+    mensagem.no = no;
+    return mensagem;
+}
+
+// Socket UDP IPv4; os erros ficam em `erro()`, como no Rastro
+class SocketUdp
+{
+public:
+    SocketUdp() = default;
+    SocketUdp(const SocketUdp&) = delete;
+    SocketUdp& operator=(const SocketUdp&) = delete;
+
+    ~SocketUdp(){
+        if (descritor >= 0) ::close(descritor);
+    }
+
+    // Abre o socket; com `porta` > 0, recebe nessa porta (nó), senão numa porta efêmera (coordenador)
+    bool abrir(int porta = 0){
+        descritor = ::socket(AF_INET, SOCK_DGRAM, 0);
+        if (descritor < 0) return falhar("socket");
+        if (porta > 0){
+            sockaddr_in endereco{};
+            endereco.sin_family = AF_INET;
+            endereco.sin_addr.s_addr = htonl(INADDR_ANY);
+            endereco.sin_port = htons(static_cast<std::uint16_t>(porta));
+            if (::bind(descritor, reinterpret_cast<sockaddr*>(&endereco), sizeof(endereco)) != 0) return falhar("bind");
+        }
+        return true;
+    }
+
+    bool enviar(const sockaddr_in &destino, const MensagemRede &mensagem){
+        return ::sendto(descritor, &mensagem, sizeof(mensagem), 0, reinterpret_cast<const sockaddr*>(&destino),
+                        sizeof(destino)) == static_cast<ssize_t>(sizeof(mensagem));
+    }
+
+    // Espera até `espera_ms` (-1 = sem limite) por uma mensagem válida; datagramas de outro
+    // tamanho ou sem a marca "JDCR" são descartados
+    bool receber(MensagemRede &mensagem, sockaddr_in &origem, int espera_ms){
+        pollfd pedido{descritor, POLLIN, 0};
+        if (::poll(&pedido, 1, espera_ms) <= 0) return false;
+        socklen_t tamanho = sizeof(origem);
+        const ssize_t lidos = ::recvfrom(descritor, &mensagem, sizeof(mensagem), 0, reinterpret_cast<sockaddr*>(&origem), &tamanho);
+        return lidos == static_cast<ssize_t>(sizeof(mensagem)) && std::memcmp(mensagem.magica, "JDCR", 4) == 0;
+    }
+
+    // "host:porta" -> endereço IPv4
+    static bool resolver(const std::string &texto, sockaddr_in &endereco, std::string &erro){
+        const std::size_t separador = texto.rfind(':');
+        if (separador == std::string::npos || separador == 0 || separador + 1 == texto.size()){
+            erro = "esperado HOST:PORTA em '" + texto + "'";
+            return false;
+        }
+        addrinfo dicas{};
+        dicas.ai_family = AF_INET;
+        dicas.ai_socktype = SOCK_DGRAM;
+        addrinfo *resultado = nullptr;
+        const int codigo = ::getaddrinfo(texto.substr(0, separador).c_str(), texto.substr(separador + 1).c_str(), &dicas, &resultado);
+        if (codigo != 0 || !resultado){
+            erro = texto + ": " + ::gai_strerror(codigo);
+            return false;
+        }
+        std::memcpy(&endereco, resultado->ai_addr, sizeof(endereco));
+        ::freeaddrinfo(resultado);
+        return true;
+    }
+
+    const std::string& erro() const{
+        return mensagem_erro;
+    }
+
+private:
+    bool falhar(const char *operacao){
+        mensagem_erro = std::string(operacao) + ": " + std::strerror(errno);
+        return false;
+    }
+
+    int descritor = -1;
+    std::string mensagem_erro;
+};
+
+// Os jogadores de um nó em uma partida: ativos, cadeiras da política local e a ordem da disputa
+template <PoliticaCadeiras Politica>
+class FragmentoJogadores
+{
+public:
+    FragmentoJogadores(std::uint32_t primeiro_id, std::uint32_t jogadores, std::uint64_t semente)
+        : primeiro_id(primeiro_id), indice_ativos(jogadores), assentos(jogadores, std::pmr::get_default_resource()),
+          perdedores(jogadores), gen(static_cast<std::mt19937::result_type>(semente)) {}
+
+    // Os ativos disputam as `cota` cadeiras do nó em ordem sorteada, como no modo simulado, ou em
+    // blocos no pool. Retorna quantos foram eliminados
+    std::uint32_t disputar(std::uint32_t cota, PoolDeTrabalho *pool){
+        assentos.nova_rodada(cota);
+        ordem.assign(indice_ativos.begin(), indice_ativos.end());
+        std::shuffle(ordem.begin(), ordem.end(), gen);
+        num_perdedores.store(0, std::memory_order_relaxed);
+
+        auto tentar = [this](std::size_t inicio, std::size_t fim) {
+            for (std::size_t i = inicio; i < fim; ++i){
+                const int id = static_cast<int>(primeiro_id + ordem[i]);
+                if (assentos.ocupar(id) == 0){
+                    perdedores[num_perdedores.fetch_add(1, std::memory_order_relaxed)] = ordem[i];
+                }
+            }
+        };
+        if (!pool || pool->tamanho() < 2){
+            tentar(0, ordem.size());
+        } else {
+            const std::size_t tamanho_bloco = std::max<std::size_t>(1, (ordem.size() + pool->tamanho() * 4 - 1) / (pool->tamanho() * 4));
+            for (std::size_t inicio = 0; inicio < ordem.size(); inicio += tamanho_bloco){
+                const std::size_t fim = std::min(ordem.size(), inicio + tamanho_bloco);
+                pool->submeter([tentar, inicio, fim] { tentar(inicio, fim); });
+            }
+            pool->aguardar();
+        }
+
+        const std::uint32_t eliminados = num_perdedores.load(std::memory_order_acquire);
+        for (std::uint32_t i = 0; i < eliminados; ++i){
+            indice_ativos.remover(perdedores[i]);
+            REGISTRAR("Jogador P%u não conseguiu uma cadeira e foi eliminado!\n", primeiro_id + perdedores[i]);
+        }
+        return eliminados;
+    }
+
+    std::uint32_t ativos() const{
+        return static_cast<std::uint32_t>(indice_ativos.tamanho());
+    }
+
+    // Id do único ativo, ou 0
+    std::uint32_t vencedor() const{
+        return indice_ativos.tamanho() == 1 ? primeiro_id + indice_ativos[0] : 0;
+    }
+
+private:
+    std::uint32_t primeiro_id;
+    IndiceAtivos indice_ativos;
+    Politica assentos;
+    std::vector<std::uint32_t> ordem;
+    std::vector<std::uint32_t> perdedores; // índices eliminados na rodada, escritos pelos blocos do pool
+    std::atomic<std::uint32_t> num_perdedores{0};
+    std::mt19937 gen;
+};
+
+// Nó de jogadores: atende coordenadores na porta `config.porta_no` até `config.partidas` partidas
+// terminarem. Roda com a política de `config.estrategia`, no pool de `config.num_threads` threads
+// no modo pool
+class NoJogadores
+{
+public:
+    bool servir(const Configuracao &config, std::string &erro){
+        if (!socket.abrir(config.porta_no)){
+            erro = socket.erro();
+            return false;
+        }
+        std::unique_ptr<PoolDeTrabalho> pool;
+        if (config.modo == ModoExecucao::Pool){
+            pool = std::make_unique<PoolDeTrabalho>(config.num_threads ? config.num_threads : std::thread::hardware_concurrency(),
+                                                    config.fixar_cpus);
+        }
+        REGISTRAR("Nó de jogadores na porta UDP %d, esperando o coordenador\n", config.porta_no);
+        com_politica(config.estrategia, [&]<typename Politica>() { atender<Politica>(config, pool.get()); });
+        return true;
+    }
+
+private:
+    // Depois da última partida, o nó ainda confirma por um tempo os `Fim` reenviados pelo
+    // coordenador, caso a confirmação anterior tenha se perdido
+    static constexpr int ESPERA_FINAL_MS = 500;
+
+    // Jogadores por fragmento: o mesmo limite de `--jogadores`
+    static constexpr std::uint32_t MAX_JOGADORES = 100000000;
+
+    // Um `Iniciar` só monta um fragmento possível: de 1 a MAX_JOGADORES jogadores, com ids de P1
+    // em diante que cabem em `int`. Um datagrama malformado ou perdido de outro programa com a
+    // marca certa não pode fazer o nó alocar um fragmento enorme
+    static bool fragmento_valido(const MensagemRede &pedido){
+        return pedido.jogadores >= 1 && pedido.jogadores <= MAX_JOGADORES && pedido.primeiro_id >= 1 &&
+               std::uint64_t{pedido.primeiro_id} + pedido.jogadores - 1 <= static_cast<std::uint64_t>(std::numeric_limits<int>::max());
+    }
+
+    static TipoMensagem resposta_para(TipoMensagem pedido){
+        switch (pedido){
+            case TipoMensagem::Iniciar: return TipoMensagem::Pronto;
+            case TipoMensagem::Parada: return TipoMensagem::Resultado;
+            case TipoMensagem::Fim: return TipoMensagem::Encerrado;
+            default: return TipoMensagem{};
+        }
+    }
+
+    template <PoliticaCadeiras Politica>
+    void atender(const Configuracao &config, PoolDeTrabalho *pool){
+        std::unique_ptr<FragmentoJogadores<Politica>> fragmento;
+        std::uint32_t partida = 0, rodada = 0;
+        MensagemRede resposta{};
+        int encerradas = 0;
+
+        for (bool ultima = false; ; ){
+            MensagemRede pedido;
+            sockaddr_in origem{};
+            if (!socket.receber(pedido, origem, ultima ? ESPERA_FINAL_MS : -1)){
+                if (ultima) return;
+                continue;
+            }
+
+            // Pedidos inválidos (fragmento impossível, cota maior que os ativos) caem no último caso
+            // e são descartados como os datagramas sem a marca, sem resposta
+            if (pedido.tipo == TipoMensagem::Iniciar && pedido.partida != partida && !ultima && fragmento_valido(pedido)){
+                partida = pedido.partida;
+                rodada = 0;
+                fragmento = std::make_unique<FragmentoJogadores<Politica>>(pedido.primeiro_id, pedido.jogadores, pedido.semente);
+                REGISTRAR("\nPartida %u: jogadores P%u a P%u neste nó\n", partida, pedido.primeiro_id,
+                          pedido.primeiro_id + pedido.jogadores - 1);
+                resposta = nova_mensagem(TipoMensagem::Pronto, partida, 0, pedido.no);
+                resposta.jogadores = fragmento->ativos();
+            } else if (pedido.tipo == TipoMensagem::Parada && pedido.partida == partida && fragmento &&
+                       pedido.rodada == rodada + 1 && pedido.cadeiras <= fragmento->ativos()){
+                rodada = pedido.rodada;
+                [[maybe_unused]] const std::uint32_t eliminados = fragmento->disputar(pedido.cadeiras, pool);
+                REGISTRAR("Rodada %u: %u cadeiras, %u eliminados, %u ativos neste nó\n", rodada, pedido.cadeiras,
+                          eliminados, fragmento->ativos());
+                resposta = nova_mensagem(TipoMensagem::Resultado, partida, rodada, pedido.no);
+                resposta.jogadores = fragmento->ativos();
+                resposta.vencedor = fragmento->vencedor();
+            } else if (pedido.tipo == TipoMensagem::Fim && pedido.partida == partida && fragmento){
+                if (pedido.vencedor){
+                    REGISTRAR("Partida %u encerrada: vencedor P%u\n", partida, pedido.vencedor);
+                } else {
+                    REGISTRAR("Partida %u interrompida\n", partida);
+                }
+                fragmento.reset();
+                resposta = nova_mensagem(TipoMensagem::Encerrado, partida, pedido.rodada, pedido.no);
+                ultima = ++encerradas >= config.partidas;
+            } else if (pedido.partida != resposta.partida || pedido.rodada != resposta.rodada ||
+                       resposta_para(pedido.tipo) != resposta.tipo){
+                continue; // de outra partida ou fora de ordem: o coordenador reenvia
+            }
+            // Pedido novo ou reenviado: a resposta guardada vale para os dois
+            socket.enviar(origem, resposta);
+        }
+    }
+
+    SocketUdp socket;
+};
+
+// Coordenador distribuído: a partida inteira, rodada a rodada, com os nós de `config.nos_distribuidos`
+class CoordenadorDistribuido
+{
+public:
+    bool executar(const Configuracao &config, ResultadoPartida &resultado, std::string &erro){
+        const std::uint64_t inicio = agora_ns();
+        if (!preparar(config, erro)) return false;
+        resultado = {};
+        resultado.vencedor = -1;
+
+        std::mt19937 gen(config.tem_semente ? static_cast<std::mt19937::result_type>(config.semente) : std::random_device{}());
+        std::uniform_int_distribution<> musica(config.musica_min_ms, config.musica_max_ms);
+        // Não vem de `gen`: duas partidas com a mesma semente teriam o mesmo id, e os nós tratariam
+        // o segundo `Iniciar` como reenvio do primeiro
+        ultima_partida += 2;
+        const std::uint32_t partida = ultima_partida;
+        const std::size_t num_nos = nos.size();
+
+        // Fragmentos contíguos de tamanhos que diferem em no máximo um jogador
+        std::vector<MensagemRede> pedidos(num_nos);
+        std::uint32_t primeiro = 1;
+        for (std::size_t i = 0; i < num_nos; ++i){
+            pedidos[i] = nova_mensagem(TipoMensagem::Iniciar, partida, 0, static_cast<std::uint32_t>(i));
+            pedidos[i].primeiro_id = primeiro;
+            const std::size_t jogadores = static_cast<std::size_t>(config.num_jogadores);
+            pedidos[i].jogadores = static_cast<std::uint32_t>(jogadores / num_nos + (i < jogadores % num_nos ? 1 : 0));
+            pedidos[i].semente = (static_cast<std::uint64_t>(gen()) << 32) | gen();
+            ativos[i] = pedidos[i].jogadores;
+            primeiro += pedidos[i].jogadores;
+        }
+        if (!trocar(pedidos, TipoMensagem::Pronto, erro)) return false;
+        resultado.ate_primeira_rodada_ns = agora_ns() - inicio; // todos os nós com o fragmento montado
+        REGISTRAR("Partida %u com %d jogadores em %zu nós\n", partida, config.num_jogadores, num_nos);
+
+        int total = config.num_jogadores;
+        std::uint32_t vencedor = 0;
+        while (total > 1 && (config.max_rodadas == 0 || resultado.rodadas < config.max_rodadas)){
+            esperar(config, musica(gen), resultado);
+            const int jogadores_rodada = total;
+            const int cadeiras = config.remocao.cadeiras_para(total);
+            REGISTRAR("\nRodada %d: %d jogadores e %d cadeiras. A música parou!\n", resultado.rodadas + 1, total, cadeiras);
+
+            // Cada cadeira removida sai de um nó sorteado com peso igual aos seus ativos
+            cotas.assign(ativos.begin(), ativos.end());
+            int restantes = total;
+            for (int e = total - cadeiras; e > 0; --e, --restantes){
+                int sorteado = std::uniform_int_distribution<>(0, restantes - 1)(gen);
+                std::size_t no = 0;
+                while (sorteado >= static_cast<int>(cotas[no])){
+                    sorteado -= static_cast<int>(cotas[no]);
+                    ++no;
+                }
+                cotas[no]--;
+            }
+
+            const std::uint64_t parada = agora_ns();
+            const std::uint32_t rodada = static_cast<std::uint32_t>(resultado.rodadas + 1);
+            for (std::size_t i = 0; i < num_nos; ++i){
+                pedidos[i] = nova_mensagem(ativos[i] ? TipoMensagem::Parada : TipoMensagem{}, partida, rodada, static_cast<std::uint32_t>(i));
+                pedidos[i].cadeiras = cotas[i];
+            }
+            if (!trocar(pedidos, TipoMensagem::Resultado, erro)) return false;
+
+            // Conciliação: cada nó tem de ter sentado exatamente a sua cota
+            total = 0;
+            for (std::size_t i = 0; i < num_nos; ++i){
+                if (!ativos[i]) continue;
+                if (respostas[i].jogadores != cotas[i]){
+                    erro = enderecos[i] + " terminou a rodada com " + std::to_string(respostas[i].jogadores) +
+                           " ativos, esperados " + std::to_string(cotas[i]);
+                    return false;
+                }
+                ativos[i] = respostas[i].jogadores;
+                total += static_cast<int>(ativos[i]);
+                if (ativos[i] == 1) vencedor = respostas[i].vencedor;
+            }
+            resultado.rodadas++;
+            if (config.coletar_estatisticas){
+                resultado.estatisticas.push_back({jogadores_rodada, cadeiras, 0, agora_ns() - parada});
+            }
+        }
+
+        if (total == 1){
+            resultado.vencedor = static_cast<int>(vencedor);
+            REGISTRAR("\n🏆 Vencedor: Jogador P%u! Parabéns! 🏆\n", vencedor);
+        } else {
+            REGISTRAR("\nPartida interrompida após %d rodadas com %d jogadores restantes.\n", resultado.rodadas, total);
+        }
+        for (std::size_t i = 0; i < num_nos; ++i){
+            pedidos[i] = nova_mensagem(TipoMensagem::Fim, partida, static_cast<std::uint32_t>(resultado.rodadas + 1), static_cast<std::uint32_t>(i));
+            pedidos[i].vencedor = total == 1 ? vencedor : 0;
+        }
+        return trocar(pedidos, TipoMensagem::Encerrado, erro);
+    }
+
+private:
+    static constexpr int REENVIO_MS = 20;
+    static constexpr int LIMITE_MS = 5000;
+
+    // Resolve os nós na primeira partida; as seguintes reaproveitam endereços e socket
+    bool preparar(const Configuracao &config, std::string &erro){
+        if (config.nos_distribuidos != lista){
+            nos.clear();
+            enderecos.clear();
+            std::stringstream ss(config.nos_distribuidos);
+            for (std::string item; std::getline(ss, item, ','); ){
+                sockaddr_in endereco{};
+                if (!SocketUdp::resolver(item, endereco, erro)) return false;
+                nos.push_back(endereco);
+                enderecos.push_back(item);
+            }
+            lista = config.nos_distribuidos;
+        }
+        if (nos.empty() || static_cast<std::size_t>(config.num_jogadores) < nos.size()){
+            erro = "são necessários ao menos um nó e um jogador por nó";
+            return false;
+        }
+        if (!aberto){
+            if (!socket.abrir()){
+                erro = socket.erro();
+                return false;
+            }
+            aberto = true;
+        }
+        ativos.assign(nos.size(), 0);
+        respostas.assign(nos.size(), MensagemRede{});
+        return true;
+    }
+
+    void esperar(const Configuracao &config, int ms, ResultadoPartida &resultado){
+        if (config.simulado){
+            resultado.tempo_virtual_ms += static_cast<std::uint64_t>(ms);
+        } else if (ms > 0){
+            std::this_thread::sleep_for(std::chrono::milliseconds(ms));
+        }
+    }
+
+    // Envia cada pedido ao seu nó (os de tipo 0 não são enviados) e espera a resposta `tipo` da
+    // mesma partida e rodada de todos, reenviando a quem não respondeu a cada REENVIO_MS
+    bool trocar(const std::vector<MensagemRede> &pedidos, TipoMensagem tipo, std::string &erro){
+        std::size_t faltam = 0;
+        std::vector<bool> respondeu(nos.size(), true);
+        for (std::size_t i = 0; i < nos.size(); ++i){
+            if (pedidos[i].tipo == TipoMensagem{}) continue;
+            respondeu[i] = false;
+            ++faltam;
+            socket.enviar(nos[i], pedidos[i]);
+        }
+
+        const auto limite = std::chrono::steady_clock::now() + std::chrono::milliseconds(LIMITE_MS);
+        auto reenvio = std::chrono::steady_clock::now() + std::chrono::milliseconds(REENVIO_MS);
+        while (faltam > 0){
+            const auto agora = std::chrono::steady_clock::now();
+            if (agora >= limite){
+                for (std::size_t i = 0; i < nos.size(); ++i){
+                    if (!respondeu[i]){
+                        erro = enderecos[i] + " não respondeu";
+                        break;
+                    }
+                }
+                return false;
+            }
+            if (agora >= reenvio){
+                for (std::size_t i = 0; i < nos.size(); ++i){
+                    if (!respondeu[i]) socket.enviar(nos[i], pedidos[i]);
+                }
+                reenvio = agora + std::chrono::milliseconds(REENVIO_MS);
+            }
+
+            MensagemRede mensagem;
+            sockaddr_in origem{};
+            const int espera = static_cast<int>(std::chrono::duration_cast<std::chrono::milliseconds>(reenvio - agora).count());
+            if (!socket.receber(mensagem, origem, std::max(1, espera))) continue;
+            const std::size_t no = mensagem.no;
+            if (no >= nos.size() || respondeu[no] || mensagem.tipo != tipo ||
+                mensagem.partida != pedidos[no].partida || mensagem.rodada != pedidos[no].rodada){
+                continue; // duplicada ou atrasada
+            }
+            respostas[no] = mensagem;
+            respondeu[no] = true;
+            --faltam;
+        }
+        return true;
+    }
+
+    SocketUdp socket;
+    bool aberto = false;
+    // Id da última partida: começa em um valor sorteado (coordenadores diferentes não colidem) e
+    // avança a cada partida; sempre ímpar, então nunca é o 0 de um nó sem partida
+    std::uint32_t ultima_partida = std::random_device{}() | 1u;
+    std::string lista;
+    std::vector<sockaddr_in> nos;
+    std::vector<std::string> enderecos;
+    std::vector<std::uint32_t> ativos;
+    std::vector<std::uint32_t> cotas;
+    std::vector<MensagemRede> respostas;
+};
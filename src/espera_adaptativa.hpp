@@ -0,0 +1,92 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+
+#include "relogio.hpp"
+
+/*
+ * Espera adaptativa entre rodadas (`--sinal adaptativo`): antes de estacionar no `std::atomic::wait`
+ * do sinal da música, o jogador gira um pouco com `pause`, se a próxima parada deve chegar logo.
+ *
+ * Com músicas curtas, estacionar e ser acordado pelo futex custa mais que a própria espera. O
+ * coordenador registra o instante de cada parada e mantém uma média móvel do intervalo entre
+ * paradas e do seu desvio (como a estimativa de RTT do TCP). Ao começar a esperar, o jogador
+ * estima quanto falta para a próxima parada: se falta pouco, gira até lá mais uma folga de dois
+ * desvios; se falta mais que `MAX_GIRO_NS`, ou ainda não há estimativa, estaciona direto.
+ *
+ * Girar só faz sentido com um núcleo livre para cada jogador além do coordenador: com mais
+ * jogadores que núcleos, quem gira tira a CPU justamente de quem vai parar a música, e a espera
+ * estaciona sempre. Cada jogador conta quantas esperas terminaram sem estacionar (girando, ou com
+ * a música já parada) e quantas estacionaram.
+ */
+class EsperaAdaptativa
+{
+public:
+    EsperaAdaptativa(unsigned num_cpus, int num_jogadores)
+        : pode_girar(num_jogadores > 0 && static_cast<unsigned>(num_jogadores) < num_cpus) {}
+
+    // Chamado só pelo coordenador, a cada parada da música
+    void registrar_sinal(std::uint64_t instante_ns){
+        const std::uint64_t anterior = ultimo_sinal.load(std::memory_order_relaxed);
+        ultimo_sinal.store(instante_ns, std::memory_order_relaxed);
+        if (anterior == 0) return;
+
+        const std::int64_t amostra = static_cast<std::int64_t>(instante_ns - anterior);
+        std::int64_t media = static_cast<std::int64_t>(intervalo.load(std::memory_order_relaxed));
+        std::int64_t variacao = static_cast<std::int64_t>(desvio.load(std::memory_order_relaxed));
+        if (media == 0){
+            media = amostra;
+            variacao = amostra / 2;
+        } else {
+            const std::int64_t erro = amostra - media;
+            media += erro / 8;
+            variacao += ((erro < 0 ? -erro : erro) - variacao) / 4;
+        }
+        intervalo.store(static_cast<std::uint64_t>(media), std::memory_order_relaxed);
+        desvio.store(static_cast<std::uint64_t>(variacao), std::memory_order_relaxed);
+    }
+
+    // Gira enquanto `pronto()` for falso e o orçamento durar; retorna `pronto()`. Quem recebe
+    // false estaciona em seguida
+    template <typename Pronto>
+    bool girar(std::uint64_t agora, Pronto &&pronto) const{
+        const std::uint64_t orcamento = orcamento_ns(agora);
+        if (orcamento == 0) return pronto();
+        const std::uint64_t limite = agora + orcamento;
+        for (;;){
+            for (unsigned i = 0; i < VOLTAS_POR_LEITURA; ++i){
+                if (pronto()) return true;
+                pausar();
+            }
+            if (agora_ns() >= limite) return pronto();
+        }
+    }
+
+    // Quanto girar a partir de `agora` (0 = estacionar direto)
+    std::uint64_t orcamento_ns(std::uint64_t agora) const{
+        const std::uint64_t media = intervalo.load(std::memory_order_relaxed);
+        if (!pode_girar || media == 0) return 0;
+        const std::uint64_t ultimo = ultimo_sinal.load(std::memory_order_relaxed);
+        const std::uint64_t decorrido = agora > ultimo ? agora - ultimo : 0;
+        const std::uint64_t falta = decorrido < media ? media - decorrido : 0;
+        if (falta > MAX_GIRO_NS) return 0;
+        const std::uint64_t orcamento = falta + 2 * desvio.load(std::memory_order_relaxed);
+        return orcamento < MAX_GIRO_NS ? orcamento : MAX_GIRO_NS;
+    }
+
+    // Média móvel do intervalo entre paradas da música, em ns (0 antes da segunda parada)
+    std::uint64_t get_intervalo_ns() const{
+        return intervalo.load(std::memory_order_relaxed);
+    }
+
+private:
+    // Acima disso estacionar e ser acordado pelo futex sai mais barato que girar
+    static constexpr std::uint64_t MAX_GIRO_NS = 50000;
+    static constexpr unsigned VOLTAS_POR_LEITURA = 64;
+
+    bool pode_girar;
+    alignas(64) std::atomic<std::uint64_t> ultimo_sinal{0};
+    std::atomic<std::uint64_t> intervalo{0};
+    std::atomic<std::uint64_t> desvio{0};
+};
@@ -0,0 +1,61 @@
+#pragma once
+
+#include <cstdint>
+#include <memory_resource>
+#include <numeric>
+#include <vector>
+
+/*
+ * Conjunto compacto dos jogadores ativos (índices em `std::vector<Jogador>`).
+ *
+ * Os ativos ficam contíguos no início de `indices`; remover um jogador troca-o com o último
+ * ativo, em O(1). Assim o coordenador conhece o número de ativos e o vencedor sem percorrer
+ * todos os jogadores, e cada rodada só visita quem ainda está no jogo.
+ */
+class IndiceAtivos
+{
+public:
+    explicit IndiceAtivos(std::size_t num_jogadores,
+                          std::pmr::memory_resource *recurso = std::pmr::get_default_resource())
+        : indices(num_jogadores, recurso), posicoes(num_jogadores, recurso), tamanho_(num_jogadores){
+        std::iota(indices.begin(), indices.end(), 0u);
+        std::iota(posicoes.begin(), posicoes.end(), 0u);
+    }
+
+    void remover(std::uint32_t indice){
+        const std::uint32_t pos = posicoes[indice];
+        if (pos >= tamanho_) return; // já removido
+
+        const std::uint32_t ultimo = indices[tamanho_ - 1];
+        indices[pos] = ultimo;
+        posicoes[ultimo] = pos;
+        indices[tamanho_ - 1] = indice;
+        posicoes[indice] = static_cast<std::uint32_t>(tamanho_ - 1);
+        --tamanho_;
+    }
+
+    bool contem(std::uint32_t indice) const{
+        return posicoes[indice] < tamanho_;
+    }
+
+    std::size_t tamanho() const{
+        return tamanho_;
+    }
+
+    std::uint32_t operator[](std::size_t i) const{
+        return indices[i];
+    }
+
+    const std::uint32_t* begin() const{
+        return indices.data();
+    }
+
+    const std::uint32_t* end() const{
+        return indices.data() + tamanho_;
+    }
+
+private:
+    std::pmr::vector<std::uint32_t> indices;  // [0, tamanho_) são os ativos
+    std::pmr::vector<std::uint32_t> posicoes; // posição de cada jogador em `indices`
+    std::size_t tamanho_;
+};
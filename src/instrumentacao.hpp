@@ -0,0 +1,209 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <bit>
+#include <cstdint>
+#include <cstdio>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+/*
+ * Instrumentação das rodadas: histogramas de latência no estilo HDR, um conjunto por thread.
+ *
+ * Cada thread que registra uma amostra recebe, na primeira vez, um bloco de contadores
+ * pré-alocado; depois disso registrar é calcular o balde e incrementar um contador que só ela
+ * escreve, sem trava e sem alocação. Quando a thread termina o bloco volta a ficar livre (com as
+ * contagens) para a próxima thread, então partidas com uma thread por jogador não acumulam blocos.
+ * O resumo soma os blocos de todas as threads.
+ *
+ * Os baldes são log-lineares: valores abaixo de 16 têm balde próprio e, acima disso, cada
+ * potência de 2 é dividida em 8 baldes, com erro relativo de no máximo 12,5%.
+ */
+enum class Metrica
+{
+    Notificacao,  // duração da notificação em parar_musica()
+    Despertar,    // da parada da música até o jogador acordar para tentar sentar
+    Resultado,    // do jogador acordar até saber se sentou ou foi eliminado
+    IniciarRodada // duração de iniciar_rodada()
+};
+
+class Histograma
+{
+public:
+    static constexpr unsigned BITS_SUB = 3;
+    static constexpr unsigned SUB = 1u << BITS_SUB;
+    static constexpr unsigned LINEAR = 2 * SUB;
+    static constexpr unsigned NUM_BALDES = LINEAR + (64 - 4) * SUB;
+
+    static unsigned balde(std::uint64_t valor){
+        if (valor < LINEAR) return static_cast<unsigned>(valor);
+        const unsigned expoente = static_cast<unsigned>(std::bit_width(valor)) - 1; // >= 4
+        const unsigned mantissa = static_cast<unsigned>(valor >> (expoente - BITS_SUB)) & (SUB - 1);
+        return LINEAR + (expoente - 4) * SUB + mantissa;
+    }
+
+    // Menor valor que cai no balde
+    static std::uint64_t limite_inferior(unsigned indice){
+        if (indice < LINEAR) return indice;
+        const unsigned expoente = (indice - LINEAR) / SUB + 4;
+        const std::uint64_t mantissa = (indice - LINEAR) % SUB;
+        return (SUB + mantissa) << (expoente - BITS_SUB);
+    }
+
+    void somar(const std::array<std::atomic<std::uint64_t>, NUM_BALDES> &contadores){
+        for (unsigned i = 0; i < NUM_BALDES; ++i){
+            baldes[i] += contadores[i].load(std::memory_order_relaxed);
+        }
+    }
+
+    std::uint64_t total() const{
+        std::uint64_t t = 0;
+        for (auto c : baldes) t += c;
+        return t;
+    }
+
+    // Limite inferior do balde que contém o quantil `q` (0 se não há amostras)
+    std::uint64_t quantil(double q) const{
+        const std::uint64_t n = total();
+        if (n == 0) return 0;
+        const std::uint64_t alvo = static_cast<std::uint64_t>(q * static_cast<double>(n - 1)) + 1;
+        std::uint64_t acumulado = 0;
+        for (unsigned i = 0; i < NUM_BALDES; ++i){
+            acumulado += baldes[i];
+            if (acumulado >= alvo) return limite_inferior(i);
+        }
+        return limite_inferior(NUM_BALDES - 1);
+    }
+
+    // Amostras em baldes que começam abaixo de `limite`; exato quando `limite` é potência de 2
+    std::uint64_t contagem_abaixo(std::uint64_t limite) const{
+        std::uint64_t acumulado = 0;
+        for (unsigned i = 0; i < NUM_BALDES && limite_inferior(i) < limite; ++i){
+            acumulado += baldes[i];
+        }
+        return acumulado;
+    }
+
+    // Soma das amostras contando cada uma pelo limite inferior do seu balde
+    std::uint64_t soma_aproximada() const{
+        std::uint64_t soma = 0;
+        for (unsigned i = 0; i < NUM_BALDES; ++i){
+            soma += baldes[i] * limite_inferior(i);
+        }
+        return soma;
+    }
+
+    std::uint64_t maximo() const{
+        for (unsigned i = NUM_BALDES; i-- > 0; ){
+            if (baldes[i]) return limite_inferior(i);
+        }
+        return 0;
+    }
+
+    // {"amostras": N, "p50": ..., "p90": ..., "p99": ..., "p999": ..., "max": ...} em ns
+    std::string para_json() const{
+        char texto[256];
+        std::snprintf(texto, sizeof(texto),
+                      "{\"amostras\": %llu, \"p50\": %llu, \"p90\": %llu, \"p99\": %llu, \"p999\": %llu, \"max\": %llu}",
+                      static_cast<unsigned long long>(total()), static_cast<unsigned long long>(quantil(0.50)),
+                      static_cast<unsigned long long>(quantil(0.90)), static_cast<unsigned long long>(quantil(0.99)),
+                      static_cast<unsigned long long>(quantil(0.999)), static_cast<unsigned long long>(maximo()));
+        return texto;
+    }
+
+private:
+    std::array<std::uint64_t, NUM_BALDES> baldes{};
+};
+
+class Instrumentacao
+{
+public:
+    static constexpr unsigned NUM_METRICAS = 4;
+
+    static Instrumentacao& instancia(){
+        static Instrumentacao instrumentacao;
+        return instrumentacao;
+    }
+
+    Instrumentacao(const Instrumentacao&) = delete;
+    Instrumentacao& operator=(const Instrumentacao&) = delete;
+
+    // Caminho quente: só a thread dona escreve nos seus contadores
+    void registrar(Metrica metrica, std::uint64_t ns){
+        auto &c = bloco_da_thread().contadores[static_cast<unsigned>(metrica)][Histograma::balde(ns)];
+        c.store(c.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+    }
+
+    Histograma histograma(Metrica metrica) const{
+        Histograma h;
+        std::lock_guard<std::mutex> lock(blocos_mutex);
+        for (auto &bloco : blocos){
+            h.somar(bloco->contadores[static_cast<unsigned>(metrica)]);
+        }
+        return h;
+    }
+
+    // Zera todas as contagens; chamado entre partidas, sem ninguém registrando
+    void zerar(){
+        std::lock_guard<std::mutex> lock(blocos_mutex);
+        for (auto &bloco : blocos){
+            for (auto &metrica : bloco->contadores){
+                for (auto &c : metrica) c.store(0, std::memory_order_relaxed);
+            }
+        }
+    }
+
+    // Objeto JSON com um histograma por métrica
+    std::string para_json() const{
+        return "{\"notificacao_ns\": " + histograma(Metrica::Notificacao).para_json() +
+               ", \"despertar_ns\": " + histograma(Metrica::Despertar).para_json() +
+               ", \"resultado_ns\": " + histograma(Metrica::Resultado).para_json() +
+               ", \"iniciar_rodada_ns\": " + histograma(Metrica::IniciarRodada).para_json() + "}";
+    }
+
+private:
+    struct Bloco
+    {
+        std::array<std::array<std::atomic<std::uint64_t>, Histograma::NUM_BALDES>, NUM_METRICAS> contadores{};
+        bool livre = false; // protegido por blocos_mutex
+    };
+
+    // Devolve o bloco para reuso quando a thread termina
+    struct Vinculo
+    {
+        Bloco *bloco = nullptr;
+        ~Vinculo(){
+            if (bloco){
+                std::lock_guard<std::mutex> lock(instancia().blocos_mutex);
+                bloco->livre = true;
+            }
+        }
+    };
+
+    Instrumentacao() = default;
+
+    Bloco& bloco_da_thread(){
+        static thread_local Vinculo vinculo;
+        if (!vinculo.bloco){
+            std::lock_guard<std::mutex> lock(blocos_mutex);
+            for (auto &bloco : blocos){
+                if (bloco->livre){
+                    bloco->livre = false;
+                    vinculo.bloco = bloco.get();
+                    break;
+                }
+            }
+            if (!vinculo.bloco){
+                blocos.push_back(std::make_unique<Bloco>());
+                vinculo.bloco = blocos.back().get();
+            }
+        }
+        return *vinculo.bloco;
+    }
+
+    mutable std::mutex blocos_mutex;
+    std::vector<std::unique_ptr<Bloco>> blocos;
+};
@@ -0,0 +1,801 @@
+#pragma once
+
+#include <thread>
+#include <vector>
+#include <mutex>
+#include <condition_variable>
+#include <atomic>
+#include <chrono>
+#include <random>
+#include <algorithm>
+#include <bit>
+#include <memory>
+#include <memory_resource>
+
+#include "configuracao.hpp"
+#include "pool_trabalho.hpp"
+#include "sinal_musica.hpp"
+#include "politicas_cadeiras.hpp"
+#include "registro.hpp"
+#include "indice_ativos.hpp"
+#include "tabela_jogadores.hpp"
+#include "instrumentacao.hpp"
+#include "corrotina.hpp"
+#include "topologia.hpp"
+#include "threads_estacionadas.hpp"
+#include "barreira_largada.hpp"
+#include "espera_adaptativa.hpp"
+#include "metricas.hpp"
+#include "rastro.hpp"
+#include "resultado.hpp"
+#include "relogio.hpp"
+
+/*
+ * Uso básico de um counting_semaphore em C++:
+ * 
+ * O `std::counting_semaphore` é um mecanismo de sincronização que permite controlar o acesso a um recurso compartilhado 
+ * com um número máximo de acessos simultâneos. Neste projeto, ele é usado para gerenciar o número de cadeiras disponíveis.
+ * Inicializamos o semáforo com `n - 1` para representar as cadeiras disponíveis no início do jogo. 
+ * Cada jogador que tenta se sentar precisa fazer um `acquire()`, e o semáforo permite que até `n - 1` jogadores 
+ * ocupem as cadeiras. Quando todos os assentos estão ocupados, jogadores adicionais ficam bloqueados até que 
+ * o coordenador libere o semáforo com `release()`, sinalizando a eliminação dos jogadores.
+ * O método `release()` também pode ser usado para liberar múltiplas permissões de uma só vez, por exemplo: `cadeira_sem.release(3);`.
+ * A `PoliticaSemaforo` usa `try_acquire()`: quem não consegue cadeira é eliminado na hora e nenhuma thread fica
+ * bloqueada, então o coordenador não precisa liberar permissões ao fim da rodada.
+ *
+ * Métodos da classe `std::counting_semaphore`:
+ * 
+ * 1. `acquire()`: Decrementa o contador do semáforo. Bloqueia a thread se o valor for zero.
+ *    - Exemplo de uso: `cadeira_sem.acquire();` // Jogador tenta ocupar uma cadeira.
+ * 
+ * 2. `release(int n = 1)`: Incrementa o contador do semáforo em `n`. Pode liberar múltiplas permissões.
+ *    - Exemplo de uso: `cadeira_sem.release(2);` // Libera 2 permissões simultaneamente.
+ *
+ * O número de jogadores é lido em tempo de execução, então o semáforo usa o valor máximo padrão
+ * (`std::counting_semaphore<>`) e pertence à `PoliticaSemaforo` do jogo, que o inicializa com `n - 1`.
+ * As outras estratégias de cadeiras são outras políticas (politicas_cadeiras.hpp), e `JogoDasCadeiras`,
+ * `Jogador` e `Coordenador` são templates da política: cada estratégia gera o seu jogo. O mesmo vale
+ * para `music_cv`, `music_mutex` e as flags da partida: todo o estado de sincronização é de cada
+ * `JogoDasCadeiras`, então várias partidas podem rodar ao mesmo tempo no processo.
+ */
+
+// Classes
+template <PoliticaCadeiras Politica = PoliticaSemaforo>
+class JogoDasCadeiras
+{
+public:
+    JogoDasCadeiras(int num_jogadores, TipoSinal tipo_sinal = TipoSinal::VariavelCondicao, bool instrumentar = false,
+                    RemocaoCadeiras remocao = {}, bool largada = false,
+                    std::pmr::memory_resource *recurso = std::pmr::get_default_resource())
+        : num_jogadores(num_jogadores), cadeiras(remocao.cadeiras_para(num_jogadores)),
+          assentos(static_cast<std::uint32_t>(cadeiras), recurso),
+          tipo_sinal(tipo_sinal), sinal(16, recurso), jogadores_na_rodada(num_jogadores),
+          tabela(static_cast<std::size_t>(num_jogadores), recurso), instrumentar(instrumentar), remocao(remocao),
+          largada(largada), barreira(Topologia::sistema().num_cpus()),
+          espera(Topologia::sistema().num_cpus(), num_jogadores) {}
+
+    void iniciar_rodada(int jogadores_ativos){
+        // TODO: Inicia uma nova rodada, removendo uma cadeira e ressincronizando o semáforo
+        // Removendo mais de uma cadeira, a rodada elimina `ativos - cadeiras` jogadores de uma vez:
+        // o semáforo e os contadores são reabastecidos com o novo total, qualquer que seja
+        const std::uint64_t inicio = instrumentar ? agora_ns() : 0;
+        cadeiras = remocao.cadeiras_para(jogadores_ativos);
+        jogadores_na_rodada = jogadores_ativos;
+        rodada++;
+        tentativas.store(0, std::memory_order_relaxed);
+        fim_tentativas_ns.store(0, std::memory_order_relaxed);
+
+        assentos.nova_rodada(static_cast<std::uint32_t>(cadeiras));
+        musica_parada.store(false); // Nova rodada
+        if (instrumentar){
+            Instrumentacao::instancia().registrar(Metrica::IniciarRodada, agora_ns() - inicio);
+        }
+
+        if (jogadores_ativos > 1){
+            REGISTRAR("\nPróxima rodada com %d jogadores e %d cadeiras.\nA música está tocando... 🎵\n\n", jogadores_ativos, cadeiras);
+        }
+    }
+
+    void parar_musica(){
+        // TODO: Simula o momento em que a música para e notifica os jogadores via variável de condição
+        const std::uint64_t inicio = instrumentar || rastro ? agora_ns() : 0;
+        parada_ns.store(inicio, std::memory_order_relaxed); // publicado junto com musica_parada
+        if (rastro){
+            rastro->registrar(TipoEvento::Rodada, rodada, static_cast<std::uint32_t>(jogadores_na_rodada),
+                              static_cast<std::uint32_t>(cadeiras), inicio);
+        }
+
+        if (tipo_sinal == TipoSinal::Adaptativo){
+            espera.registrar_sinal(agora_ns());
+        }
+        if (usa_sinal_atomico()){
+            musica_parada.store(true, std::memory_order_release);
+            sinal.sinalizar(); // sem mutex: cada fragmento acorda os seus jogadores
+        } else {
+            { // bloqueio atomico
+                std::unique_lock<std::mutex> lock(music_mutex);
+                musica_parada.store(true, std::memory_order_release);
+            }
+
+            music_cv.notify_all(); //avisa que a musica parou
+        }
+        if (instrumentar){
+            Instrumentacao::instancia().registrar(Metrica::Notificacao, agora_ns() - inicio);
+        }
+        REGISTRAR("> A música parou! Os jogadores estão tentando se sentar...\n\n----------------------------------------------------------\n");
+    }
+
+    // Acorda todos os jogadores para que percebam o fim do jogo
+    void encerrar(){
+        {
+            std::lock_guard<std::mutex> lock(music_mutex);
+            em_andamento.store(false, std::memory_order_release);
+        }
+        if (usa_sinal_atomico()){
+            sinal.sinalizar();
+        }
+        music_cv.notify_all();
+    }
+
+    // Chamado por cada jogador depois de tentar sentar; o último marca o instante em que
+    // todos os jogadores da rodada terminaram de disputar as cadeiras e acorda o coordenador
+    void registrar_tentativa(){
+        if (tentativas.fetch_add(1, std::memory_order_acq_rel) + 1 == jogadores_na_rodada){
+            fim_tentativas_ns.store(agora_ns(), std::memory_order_release);
+            tentativas.notify_all();
+        }
+    }
+
+    // Contagem regressiva da rodada: bloqueia até o último jogador ativo ter tentado sentar.
+    // Só a última tentativa notifica; as anteriores mudam o valor sem acordar ninguém
+    void aguardar_tentativas(){
+        for (int vistas = tentativas.load(std::memory_order_acquire); vistas < jogadores_na_rodada;
+             vistas = tentativas.load(std::memory_order_acquire)){
+            tentativas.wait(vistas, std::memory_order_acquire);
+        }
+    }
+
+    // Instante (agora_ns) da última tentativa da rodada, ou 0 se alguém ainda não tentou
+    std::uint64_t get_fim_tentativas_ns() const{
+        return fim_tentativas_ns.load(std::memory_order_acquire);
+    }
+
+    int get_cadeiras() const{
+        return cadeiras;
+    }
+
+    TabelaJogadores& get_tabela(){
+        return tabela;
+    }
+
+    bool esta_em_andamento() const{
+        return em_andamento.load(std::memory_order_acquire);
+    }
+
+    bool musica_parou() const{
+        return musica_parada.load(std::memory_order_acquire);
+    }
+
+    // Bloqueia na variável de condição até a música parar ou a partida acabar. Quem já tentou
+    // nesta rodada volta a dormir até a próxima parada em vez de girar enquanto os outros tentam
+    void esperar_musica_cv(std::size_t indice){
+        std::unique_lock<std::mutex> lock(music_mutex);
+        music_cv.wait(lock, [this, indice] {
+            return (musica_parada.load(std::memory_order_acquire) && !tabela.tentou(indice)) ||
+                  !em_andamento.load(std::memory_order_acquire);
+        });
+    }
+
+    // `co_await` de uma corrotina de jogador: mesma condição de esperar_musica_cv(), mas em vez de
+    // bloquear a corrotina se suspende até o coordenador retomá-la na próxima parada da música.
+    // O resultado é o instante em que o jogador acordou (0 sem instrumentação)
+    struct MusicaParada
+    {
+        JogoDasCadeiras *jogo;
+        std::size_t indice;
+
+        bool await_ready() const{
+            return (jogo->musica_parou() && !jogo->tabela.tentou(indice)) || !jogo->esta_em_andamento();
+        }
+        void await_suspend(std::coroutine_handle<>) const noexcept {}
+        std::uint64_t await_resume() const{
+            return jogo->instrumentando() ? agora_ns() : 0;
+        }
+    };
+
+    MusicaParada musica_parada_aguardavel(std::size_t indice){
+        return {this, indice};
+    }
+
+    bool instrumentando() const{
+        return instrumentar;
+    }
+
+    // Instante (agora_ns) da última parada da música; só é medido com a instrumentação ligada
+    std::uint64_t get_parada_ns() const{
+        return parada_ns.load(std::memory_order_relaxed);
+    }
+
+    // Com um rastro, cada parada da música e cada tentativa de sentar viram um evento nele
+    void rastrear_em(Rastro *destino){
+        rastro = destino;
+    }
+
+    // Resultado de uma tentativa (cadeira 0 = eliminado)
+    void rastrear_tentativa(int jogador_id, int cadeira){
+        if (rastro){
+            rastro->registrar(cadeira ? TipoEvento::Sentou : TipoEvento::Eliminado, rodada,
+                              static_cast<std::uint32_t>(jogador_id), static_cast<std::uint32_t>(cadeira), agora_ns());
+        }
+    }
+
+    std::uint32_t get_rodada() const{
+        return rodada;
+    }
+
+    bool usa_largada() const{
+        return largada;
+    }
+
+    // Segura o jogador na barreira até todos os ativos da rodada chegarem a ela
+    void aguardar_largada(){
+        barreira.aguardar(jogadores_na_rodada);
+    }
+
+    // O sinal adaptativo também é o contador de geração, só muda como o jogador espera
+    bool usa_sinal_atomico() const{
+        return tipo_sinal != TipoSinal::VariavelCondicao;
+    }
+
+    bool usa_espera_adaptativa() const{
+        return tipo_sinal == TipoSinal::Adaptativo;
+    }
+
+    // Gira, se valer a pena, até a geração do sinal passar de `vista`; false = vai estacionar
+    bool girar_ate_musica(int jogador_id, std::uint32_t vista) const{
+        return espera.girar(agora_ns(), [&] {
+            return sinal.geracao(static_cast<unsigned>(jogador_id)) != vista;
+        });
+    }
+
+    // Espera (sem mutex) a geração do sinal passar de `vista`
+    std::uint32_t esperar_musica(int jogador_id, std::uint32_t vista) const{
+        return sinal.esperar(static_cast<unsigned>(jogador_id), vista);
+    }
+
+    // Retorna o número da cadeira ocupada (a partir de 1) ou 0 se não conseguiu
+    // Chamada direta à política: sem teste da estratégia no caminho de cada tentativa
+    int ocupar_cadeira(int jogador_id){
+        return assentos.ocupar(jogador_id);
+    }
+
+    const Politica& get_assentos() const{
+        return assentos;
+    }
+
+    int get_num_jogadores() const{
+        return num_jogadores;
+    }
+
+    void exibir_estado(){
+        // TODO: Exibe o estado atual das cadeiras e dos jogadores
+        REGISTRAR("Rodada atual com %d cadeiras disponíveis.\n", cadeiras);
+        assentos.exibir_ocupantes();
+    }
+
+    bool jogo_ativo(int jogadores_ativos) const{
+        return jogadores_ativos > 1; //se tem mais de um entao ninguem ganhou ainda
+    }
+
+private:
+    int num_jogadores;
+    int cadeiras;
+    Politica assentos; // as cadeiras da rodada, na estratégia escolhida
+    TipoSinal tipo_sinal;
+    SinalMusica sinal;
+    int jogadores_na_rodada;
+    alignas(64) std::atomic<int> tentativas{0};
+    std::atomic<std::uint64_t> fim_tentativas_ns{0};
+    TabelaJogadores tabela;
+
+    // Sincronização da música (antes variáveis globais)
+    std::condition_variable music_cv;
+    std::mutex music_mutex;
+    std::atomic<bool> musica_parada{false};
+    std::atomic<bool> em_andamento{true};
+
+    bool instrumentar;
+    std::atomic<std::uint64_t> parada_ns{0};
+    RemocaoCadeiras remocao;
+    bool largada;
+    BarreiraLargada barreira;
+    EsperaAdaptativa espera;
+    std::uint32_t rodada = 1; // só o coordenador muda, entre rodadas
+    Rastro *rastro = nullptr;
+};
+
+template <PoliticaCadeiras Politica = PoliticaSemaforo>
+class Jogador
+{
+public:
+    // As flags "ativo" e "tentou nesta rodada" ficam na TabelaJogadores do jogo; o Jogador em si
+    // não tem atômicos e pode ser copiado e movido normalmente
+    Jogador(int id, JogoDasCadeiras<Politica> &jogo)
+        : id(id), jogo(&jogo), tabela(&jogo.get_tabela()) {}
+
+    bool esta_ativo() const{
+        return tabela->esta_ativo(indice());
+    }
+
+    int get_id() const{
+        return id;
+    }
+
+    void reseta_rodada(){
+        tabela->limpar_tentativa(indice());
+    }
+
+    // `acordou_ns` é o instante em que a thread do jogador acordou (0 = agora, para quem é
+    // chamado direto pelo pool ou pelo coordenador)
+    void tentar_ocupar_cadeira(std::uint64_t acordou_ns = 0){
+        // TODO: Tenta ocupar uma cadeira utilizando o semáforo contador quando a música para (aguarda pela variável de condição)
+        // if (ativo && !tentou_rodada){
+        //     tentou_rodada = true; 
+        //     verificar_eliminacao();
+        // }
+        if (esta_ativo() && tabela->marcar_tentativa(indice())) {
+            if (jogo->instrumentando()){
+                if (acordou_ns == 0) acordou_ns = agora_ns();
+                const std::uint64_t parada = jogo->get_parada_ns();
+                Instrumentacao::instancia().registrar(Metrica::Despertar, acordou_ns > parada ? acordou_ns - parada : 0);
+            }
+            if (jogo->usa_largada()){
+                jogo->aguardar_largada();
+                if (acordou_ns) acordou_ns = agora_ns(); // o resultado mede só a disputa
+            }
+            verificar_eliminacao(acordou_ns);
+            jogo->registrar_tentativa();
+        }
+    }
+
+    void verificar_eliminacao(std::uint64_t acordou_ns = 0){
+        // TODO: Verifica se foi eliminado após ser destravado do semáforo
+        // if (cadeira_sem.try_acquire()){
+        //     std::cout << "[Cadeira " << numero_cadeira++ << "]: Ocupada por P" << id << "\n";
+        // } else { 
+        //     ativo = false; 
+        //     std::cout << "\nJogador P" << id << " não conseguiu uma cadeira e foi eliminado!\n";
+        //     std::cout << "----------------------------------------------------------\n";
+        // }
+        const int cadeira = jogo->ocupar_cadeira(id);
+        if (acordou_ns){
+            Instrumentacao::instancia().registrar(Metrica::Resultado, agora_ns() - acordou_ns);
+        }
+        jogo->rastrear_tentativa(id, cadeira);
+
+        if (cadeira) {
+            REGISTRAR("[Cadeira %d]: Ocupada por P%d\n", cadeira, id);
+        } else {
+            tabela->eliminar(indice()); // o coordenador acha os eliminados na tabela, ao fim da rodada
+            REGISTRAR("\nJogador P%d não conseguiu uma cadeira e foi eliminado!\n----------------------------------------------------------\n", id);
+        }
+    }
+
+    void joga(){
+        //  while (ativo && jogo_ativo.load()){  // Verifica se o jogo ainda está ativo
+        //     std::unique_lock<std::mutex> lock(music_mutex);
+        //     music_cv.wait(lock, [] { return musica_parada.load() || !jogo_ativo.load(); });
+
+        //     if (!jogo_ativo.load()) break;  // Termina a execução se o jogo acabou
+
+        //     tentar_ocupar_cadeira();
+        // }
+        if (jogo->usa_sinal_atomico()){
+            joga_sinal_atomico();
+            return;
+        }
+
+        while (esta_ativo() && jogo->esta_em_andamento()) {
+            jogo->esperar_musica_cv(indice());
+            const std::uint64_t acordou = jogo->instrumentando() ? agora_ns() : 0;
+
+            if (!jogo->esta_em_andamento()) break;
+
+            tentar_ocupar_cadeira(acordou);
+        }
+    }
+
+    // Versão corrotina de joga(): o laço é o mesmo, mas a espera é um co_await
+    CorrotinaJogador joga_corrotina(){
+        while (esta_ativo() && jogo->esta_em_andamento()) {
+            const std::uint64_t acordou = co_await jogo->musica_parada_aguardavel(indice());
+
+            if (!jogo->esta_em_andamento()) break;
+
+            tentar_ocupar_cadeira(acordou);
+        }
+    }
+
+    void joga_sinal_atomico(){
+        // Cada parada da música é uma nova geração; o jogador tenta uma vez por geração.
+        // Começa em 0 para que uma thread iniciada depois da primeira parada não a perca.
+        std::uint32_t vista = 0;
+        while (esta_ativo() && jogo->esta_em_andamento()) {
+            if (jogo->usa_espera_adaptativa()){
+                if (jogo->girar_ate_musica(id, vista)) esperas_girando++;
+                else esperas_estacionadas++;
+            }
+            vista = jogo->esperar_musica(id, vista);
+            const std::uint64_t acordou = jogo->instrumentando() ? agora_ns() : 0;
+
+            if (!jogo->esta_em_andamento()) break;
+
+            if (jogo->musica_parou()){
+                tentar_ocupar_cadeira(acordou);
+            }
+        }
+    }
+
+    // Esperas adaptativas (--sinal adaptativo) que terminaram sem estacionar e que estacionaram
+    std::uint64_t get_esperas_girando() const{
+        return esperas_girando;
+    }
+    std::uint64_t get_esperas_estacionadas() const{
+        return esperas_estacionadas;
+    }
+
+private:
+    int id;
+    JogoDasCadeiras<Politica> *jogo;
+    TabelaJogadores *tabela;
+    std::uint64_t esperas_girando = 0; // só a thread do jogador conta; lidos depois da partida
+    std::uint64_t esperas_estacionadas = 0;
+
+    std::size_t indice() const{
+        return static_cast<std::size_t>(id - 1);
+    }
+};
+
+template <PoliticaCadeiras Politica = PoliticaSemaforo>
+class Coordenador{
+public:
+    // Sem pool, cada jogador roda na própria thread (Jogador::joga); com pool, o coordenador
+    // despacha as tentativas dos jogadores como tarefas quando a música para. No modo simulado
+    // o próprio coordenador faz as tentativas, uma a uma, na ordem sorteada
+    // No modo corrotina, o coordenador retoma as corrotinas dos ativos (no pool, se houver)
+    Coordenador(JogoDasCadeiras<Politica> &jogo, std::pmr::vector<Jogador<Politica>> &jogadores, const Configuracao &config,
+                PoolDeTrabalho *pool = nullptr, std::pmr::vector<CorrotinaJogador> *corrotinas = nullptr,
+                std::pmr::memory_resource *recurso = std::pmr::get_default_resource())
+        : jogo(jogo), jogadores(jogadores), config(config), pool(pool), corrotinas(corrotinas),
+          indice_ativos(jogadores.size(), recurso), ordem(recurso),
+          mascara_eliminados(jogo.get_tabela().num_palavras(), 0, recurso), estatisticas(recurso),
+          metricas(Metricas::instancia().esta_ativa() ? &Metricas::instancia() : nullptr) {}
+
+    void iniciar_jogo(){
+        // TODO: Começa o jogo, dorme por um período aleatório, e então para a música, sinalizando os jogadores 
+        std::mt19937 gen(semente_inicial());
+        std::uniform_int_distribution<> dist(config.musica_min_ms, config.musica_max_ms);
+
+        int ativos = jogadores_ativos();
+        if (metricas) metricas->iniciar_partida(ativos);
+        primeira_rodada_ns = agora_ns();
+        while (jogo.jogo_ativo(ativos) && (config.max_rodadas == 0 || rodadas < config.max_rodadas)){
+            esperar(dist(gen));
+            const int cadeiras_rodada = jogo.get_cadeiras();
+            const std::uint64_t parada = agora_ns();
+            jogo.parar_musica();
+
+            if (config.simulado){
+                disputar_em_ordem(gen);
+            } else if (corrotinas){
+                retomar_corrotinas(gen); // cada retomada só volta depois da tentativa
+            } else if (pool){
+                despachar_jogadores();
+            } else {
+                jogo.aguardar_tentativas(); // a rodada dura o tempo que os jogadores levam, não um sleep fixo
+                esperar(config.espera_ms);
+            }
+            const int eliminados_rodada = processar_eliminacoes();
+            ativos = jogadores_ativos();
+            rodadas++;
+
+            // Agregação das métricas ao vivo: uma vez por rodada, fora do caminho dos jogadores
+            if (metricas){
+                metricas->registrar_rodada(agora_ns(), eliminados_rodada);
+            }
+
+            if (config.coletar_estatisticas){
+                const std::uint64_t eliminacao = agora_ns();
+                const std::uint64_t sentados = jogo.get_fim_tentativas_ns();
+                estatisticas.push_back({ativos_antes, cadeiras_rodada,
+                                        sentados > parada ? sentados - parada : 0,
+                                        eliminacao - parada});
+            }
+
+            jogo.iniciar_rodada(ativos);
+            reseta_rodada_jogadores();
+            ativos_antes = ativos;
+        }
+
+        if (ativos == 1){
+            REGISTRAR("\n🏆 Vencedor: Jogador P%d! Parabéns! 🏆\n\n----------------------------------------------------------\n", encontrar_vencedor());
+        } else {
+            REGISTRAR("\nPartida interrompida após %d rodadas com %d jogadores restantes.\n", rodadas, ativos);
+        }
+        if (config.simulado){
+            REGISTRAR("Tempo simulado: %.3f s\n", tempo_virtual_ms / 1000.0);
+        }
+        if (metricas) metricas->encerrar_partida(agora_ns(), ativos);
+
+        jogo.encerrar();
+    }
+
+    std::uint64_t get_tempo_virtual_ms() const{
+        return tempo_virtual_ms;
+    }
+
+    int get_rodadas() const{
+        return rodadas;
+    }
+
+    // Instante em que a música da primeira rodada começou
+    std::uint64_t get_primeira_rodada_ns() const{
+        return primeira_rodada_ns;
+    }
+
+    const std::pmr::vector<EstatisticaRodada>& get_estatisticas() const{
+        return estatisticas;
+    }
+
+    std::mt19937::result_type semente_inicial() const{
+        if (config.tem_semente){
+            return static_cast<std::mt19937::result_type>(config.semente);
+        }
+        std::random_device rd;
+        return rd();
+    }
+
+    // No modo simulado o tempo só avança no relógio virtual
+    void esperar(int ms){
+        if (config.simulado){
+            tempo_virtual_ms += static_cast<std::uint64_t>(ms);
+        } else if (ms > 0){
+            std::this_thread::sleep_for(std::chrono::milliseconds(ms));
+        }
+    }
+
+    // A disputa pelas cadeiras vira uma permutação sorteada: mesma semente, mesmo resultado
+    void disputar_em_ordem(std::mt19937 &gen){
+        ordem.assign(indice_ativos.begin(), indice_ativos.end());
+        std::shuffle(ordem.begin(), ordem.end(), gen);
+        for (std::uint32_t i : ordem){
+            jogadores[i].tentar_ocupar_cadeira();
+        }
+    }
+
+    // Aplica `funcao` a cada índice de jogador de `indices`: direto na thread do coordenador sem
+    // pool, ou em blocos no pool. Volta só depois de todas as chamadas terminarem
+    template <typename Funcao>
+    void para_cada(const std::uint32_t *indices, std::size_t total, Funcao funcao){
+        if (!pool){
+            for (std::size_t i = 0; i < total; ++i){
+                funcao(indices[i]);
+            }
+            return;
+        }
+
+        // Divide os jogadores ativos em poucos blocos por thread do pool: cada bloco é uma tarefa
+        // barata. Os índices só mudam entre rodadas, então as tarefas podem lê-los sem trava
+        const std::size_t blocos = static_cast<std::size_t>(pool->tamanho()) * 4;
+        const std::size_t tamanho_bloco = std::max<std::size_t>(1, (total + blocos - 1) / blocos);
+
+        for (std::size_t inicio = 0; inicio < total; inicio += tamanho_bloco){
+            std::size_t fim = std::min(total, inicio + tamanho_bloco);
+            pool->submeter([funcao, indices, inicio, fim] {
+                for (std::size_t i = inicio; i < fim; ++i){
+                    funcao(indices[i]);
+                }
+            });
+        }
+        pool->aguardar();
+    }
+
+    void despachar_jogadores(){
+        para_cada(indice_ativos.begin(), indice_ativos.tamanho(),
+                  [this](std::uint32_t i) { jogadores[i].tentar_ocupar_cadeira(); });
+    }
+
+    // As corrotinas não disputam por ordem de chegada como as threads: sem sortear a ordem, o
+    // executor sem pool retomaria sempre P1 primeiro e ele nunca perderia a cadeira
+    void retomar_corrotinas(std::mt19937 &gen){
+        ordem.assign(indice_ativos.begin(), indice_ativos.end());
+        std::shuffle(ordem.begin(), ordem.end(), gen);
+        para_cada(ordem.data(), ordem.size(), [this](std::uint32_t i) { (*corrotinas)[i].retomar(); });
+    }
+
+    // Tira do índice de ativos quem foi eliminado na rodada e retorna quantos. Chamado com todos
+    // os jogadores da rodada já tendo tentado: a máscara de eliminados sai de uma varredura
+    // vetorial da tabela, e só as palavras com algum eliminado são percorridas bit a bit
+    int processar_eliminacoes(){
+        const std::size_t eliminados = jogo.get_tabela().eliminados_da_rodada(mascara_eliminados.data());
+        for (std::size_t p = 0; p < mascara_eliminados.size() && eliminados > 0; ++p){
+            for (std::uint64_t bits = mascara_eliminados[p]; bits != 0; bits &= bits - 1){
+                indice_ativos.remover(static_cast<std::uint32_t>(p * 64 + static_cast<std::size_t>(std::countr_zero(bits))));
+            }
+        }
+        return static_cast<int>(eliminados);
+    }
+
+    int jogadores_ativos() const{
+        return static_cast<int>(indice_ativos.tamanho());
+    }
+
+    int encontrar_vencedor() const{
+        if (indice_ativos.tamanho() == 1){
+            return jogadores[indice_ativos[0]].get_id();
+        }
+        return -1;
+    }
+
+    void reseta_rodada_jogadores(){
+        // Zera as tentativas de 64 jogadores por palavra, 4 ou 8 palavras por instrução
+        jogo.get_tabela().limpar_tentativas();
+    }
+
+private:
+    JogoDasCadeiras<Politica> &jogo;
+    std::pmr::vector<Jogador<Politica>> &jogadores;
+    const Configuracao &config;
+    PoolDeTrabalho *pool;
+    std::pmr::vector<CorrotinaJogador> *corrotinas;
+    IndiceAtivos indice_ativos;
+    std::pmr::vector<std::uint32_t> ordem;
+    std::pmr::vector<std::uint64_t> mascara_eliminados; // escrita em processar_eliminacoes
+    std::uint64_t tempo_virtual_ms = 0;
+    std::uint64_t primeira_rodada_ns = 0;
+    int rodadas = 0;
+    int ativos_antes = static_cast<int>(jogadores.size());
+    std::pmr::vector<EstatisticaRodada> estatisticas;
+    Metricas *metricas; // nullptr sem --metricas
+};
+
+// Monta o jogo, os jogadores e o coordenador, executa uma partida completa e espera todas as
+// threads terminarem. Tudo o que a partida aloca vem de `recurso` (a arena de um ContextoPartida)
+// e é liberado antes do retorno; só `resultado.estatisticas` sobrevive, reaproveitando a sua
+// capacidade. Com `pool_externo`, os modos que usam pool usam esse em vez de criar um; com
+// `estacionadas`, o coordenador e as threads dos jogadores são threads já existentes, acordadas
+// para a partida, em vez de criadas e juntadas. Com `rastro`, os eventos da partida são gravados nele.
+// `resultado.ate_primeira_rodada_ns` mede a montagem: alocar o jogo, criar ou acordar as threads.
+// `config.estrategia` é ignorada: a estratégia é a `Politica` (veja executar_partida abaixo)
+template <PoliticaCadeiras Politica>
+void executar_partida_com(const Configuracao &config, std::pmr::memory_resource *recurso,
+                          PoolDeTrabalho *pool_externo, ResultadoPartida &resultado,
+                          ThreadsEstacionadas *estacionadas = nullptr, Rastro *rastro = nullptr){
+    const std::uint64_t inicio = agora_ns();
+    const int num_jogadores = config.num_jogadores;
+
+    // A largada só existe no modo threads: no pool e nas corrotinas os jogadores não estão todos
+    // rodando ao mesmo tempo e ninguém chegaria depois de quem está esperando na barreira
+    const bool largada = config.largada && config.modo == ModoExecucao::Threads && !config.simulado;
+    JogoDasCadeiras<Politica> jogo(num_jogadores, config.sinal, config.instrumentar, config.remocao, largada, recurso);
+    if (rastro){
+        jogo.rastrear_em(rastro);
+        rastro->registrar(TipoEvento::Partida, 0, static_cast<std::uint32_t>(num_jogadores),
+                          rastro->iniciar_partida(), agora_ns());
+    }
+    std::pmr::vector<Jogador<Politica>> jogadores(recurso);
+    jogadores.reserve(num_jogadores); // evita realocações durante a criação
+
+    // Criação das threads dos jogadores
+    for (int i = 1; i <= num_jogadores; ++i){
+        jogadores.emplace_back(i, jogo);
+    }
+
+    std::unique_ptr<PoolDeTrabalho> pool_proprio;
+    PoolDeTrabalho *pool = nullptr;
+    std::pmr::vector<std::thread> threads_jogadores(recurso);
+    std::pmr::vector<CorrotinaJogador> corrotinas(recurso);
+
+    auto usar_pool = [&](unsigned num_threads) {
+        if (pool_externo){
+            pool = pool_externo;
+        } else {
+            pool_proprio = std::make_unique<PoolDeTrabalho>(num_threads, config.fixar_cpus);
+            pool = pool_proprio.get();
+        }
+    };
+
+    if (config.simulado){
+        // O coordenador faz todas as tentativas: nenhuma thread de jogador
+    } else if (config.modo == ModoExecucao::Corrotina){
+        CorrotinaJogador::RecursoDosQuadros quadros(recurso);
+        corrotinas.reserve(num_jogadores);
+        for (auto &jogador : jogadores){
+            corrotinas.push_back(jogador.joga_corrotina()); // começa suspensa
+        }
+        if (config.num_threads > 1){
+            usar_pool(config.num_threads);
+        }
+    } else if (config.modo == ModoExecucao::Pool){
+        usar_pool(config.num_threads ? config.num_threads : std::thread::hardware_concurrency());
+    } else if (!estacionadas){
+        threads_jogadores.reserve(num_jogadores);
+        for (auto &jogador : jogadores){
+            threads_jogadores.emplace_back(&Jogador<Politica>::joga, &jogador);
+            if (config.fixar_cpus){
+                // A CPU 0 da ordem fica com o coordenador; os jogadores começam na seguinte
+                Topologia::fixar(threads_jogadores.back().native_handle(),
+                                 Topologia::sistema().cpu_para(threads_jogadores.size()));
+            }
+        }
+    }
+
+    Coordenador<Politica> coordenador(jogo, jogadores, config, pool, corrotinas.empty() ? nullptr : &corrotinas, recurso);
+
+    // Thread do coordenador; no modo simulado não há com quem concorrer e a partida roda
+    // na própria thread que chamou (assim o torneio executa uma mesa por tarefa do pool)
+    std::thread thread_coordenador;
+    if (config.simulado){
+        coordenador.iniciar_jogo();
+    } else if (estacionadas){
+        // Thread 0 para o coordenador e, no modo threads, uma thread por jogador a seguir (a
+        // mesma distribuição de CPUs de quando as threads são criadas aqui)
+        const bool com_threads = config.modo == ModoExecucao::Threads;
+        auto tarefa = [&](std::size_t i) {
+            if (i == 0){
+                coordenador.iniciar_jogo();
+            } else {
+                jogadores[i - 1].joga();
+            }
+        };
+        estacionadas->executar(com_threads ? jogadores.size() + 1 : 1, config.fixar_cpus, tarefa);
+    } else {
+        thread_coordenador = std::thread(&Coordenador<Politica>::iniciar_jogo, &coordenador);
+        if (config.fixar_cpus){
+            Topologia::fixar(thread_coordenador.native_handle(), Topologia::sistema().cpu_para(0));
+        }
+    }
+
+    // Esperar pelas threads dos jogadores
+    for (auto &t : threads_jogadores) {
+        if (t.joinable()){
+            t.join();
+        }
+    }
+
+    // Esperar pela thread do coordenador
+    if (thread_coordenador.joinable()){
+        thread_coordenador.join();
+    }
+
+    resultado.vencedor = coordenador.jogadores_ativos() == 1 ? coordenador.encontrar_vencedor() : -1;
+    resultado.rodadas = coordenador.get_rodadas();
+    resultado.tempo_virtual_ms = coordenador.get_tempo_virtual_ms();
+    resultado.ate_primeira_rodada_ns = coordenador.get_primeira_rodada_ns() - inicio;
+    resultado.estatisticas.assign(coordenador.get_estatisticas().begin(), coordenador.get_estatisticas().end());
+    resultado.esperas_girando = 0;
+    resultado.esperas_estacionadas = 0;
+    for (const auto &jogador : jogadores){
+        resultado.esperas_girando += jogador.get_esperas_girando();
+        resultado.esperas_estacionadas += jogador.get_esperas_estacionadas();
+    }
+    if (rastro){
+        rastro->registrar(TipoEvento::Vencedor, static_cast<std::uint32_t>(resultado.rodadas),
+                          static_cast<std::uint32_t>(std::max(resultado.vencedor, 0)), 0, agora_ns());
+    }
+}
+
+// Seletor em tempo de execução: instancia a partida para a política de `config.estrategia`
+inline void executar_partida(const Configuracao &config, std::pmr::memory_resource *recurso,
+                             PoolDeTrabalho *pool_externo, ResultadoPartida &resultado,
+                             ThreadsEstacionadas *estacionadas = nullptr, Rastro *rastro = nullptr){
+    com_politica(config.estrategia, [&]<PoliticaCadeiras Politica>() {
+        executar_partida_com<Politica>(config, recurso, pool_externo, resultado, estacionadas, rastro);
+    });
+}
+
+inline ResultadoPartida executar_partida(const Configuracao &config, Rastro *rastro = nullptr){
+    ResultadoPartida resultado{};
+    executar_partida(config, std::pmr::get_default_resource(), nullptr, resultado, nullptr, rastro);
+    return resultado;
+}
@@ -1,294 +1,303 @@
 #include <iostream>
-#include <thread>
-#include <vector>
-#include <mutex>
-#include <condition_variable>
-#include <semaphore>
-#include <atomic>
+#include <string>
+#include <cstdlib>
 #include <chrono>
-#include <random>
 
-// Global variables for synchronization
-constexpr int NUM_JOGADORES = 4;
-std::counting_semaphore<NUM_JOGADORES> cadeira_sem(NUM_JOGADORES - 1); // Inicia com n-1 cadeiras, capacidade máxima n
-std::condition_variable music_cv;
-std::mutex music_mutex;
-std::mutex cout_mutex; 
-std::atomic<bool> musica_parada{false};
-std::atomic<bool> jogo_ativo{true};
-std::atomic<int> numero_cadeira = 1; 
+// A interface em texto é só mais um usuário da biblioteca MotorCadeiras
+#include "motor.hpp"
+#include "nomes_configuracao.hpp"
+#include "rastro.hpp"
+#include "registro.hpp"
+
+void exibir_uso(const char *programa){
+    std::cerr << "Uso: " << programa << " [num_jogadores] [opções]\n"
+              << "  --jogadores N         número de jogadores (mínimo 2, padrão 4)\n"
+              << "  --modo threads|pool|corrotina\n"
+              << "                        uma thread por jogador (padrão), pool de hardware_concurrency()\n"
+              << "                        threads ou uma corrotina por jogador (com --threads N > 1, as\n"
+              << "                        corrotinas são retomadas em um pool de N threads)\n"
+              << "  --sinal cv|atomico|adaptativo\n"
+              << "                        como as threads dos jogadores esperam a música parar (padrão cv);\n"
+              << "                        adaptativo gira antes de estacionar quando a música está curta\n"
+              << "  --cadeiras semaforo|contador|vetor|numa|hierarquico\n"
+              << "                        como as cadeiras são disputadas (padrão semaforo); numa\n"
+              << "                        divide as cadeiras por nó NUMA e tenta o nó local primeiro;\n"
+              << "                        hierarquico usa reservas por thread recarregadas em lotes\n"
+              << "  --fixar               fixa coordenador, jogadores e trabalhadoras em núcleos, nó a nó\n"
+              << "  --silencioso          não exibe as mensagens do jogo\n"
+              << "  --semente S           semente do gerador aleatório (padrão: std::random_device)\n"
+              << "  --musica MIN MAX      duração da música em ms (padrão 1000 3000)\n"
+              << "  --espera MS           pausa extra após todos tentarem sentar, no modo threads (padrão 0)\n"
+              << "  --threads N           threads do pool no modo pool (padrão hardware_concurrency())\n"
+              << "  --max-rodadas N       interrompe a partida após N rodadas (padrão 0, sem limite)\n"
+              << "  --simulado            tempo virtual, sem sleeps, e disputa sequencial na ordem\n"
+              << "                        sorteada pela semente: o resultado é reproduzível\n"
+              << "  --remover K|P%        cadeiras removidas por rodada: K fixas ou P% dos ativos\n"
+              << "                        (padrão 1; 50% leva a log2(N) rodadas)\n"
+              << "  --instrumentar        ao final, exibe em JSON os histogramas de latência das rodadas\n"
+              << "  --torneio M           torneio em chaves com mesas de M jogadores, executadas em\n"
+              << "                        paralelo no pool (--threads); o vencedor de cada mesa avança\n"
+              << "  --partidas K          K partidas seguidas, reaproveitando threads e memória (padrão 1)\n"
+              << "  --largada             modo threads: os jogadores acordados esperam em uma barreira e\n"
+              << "                        disputam as cadeiras todos ao mesmo tempo\n"
+              << "  --inicio-rapido       aloca a memória da partida e cria as threads (em paralelo) antes\n"
+              << "                        da primeira rodada; com ele ou --instrumentar, exibe o tempo até ela\n"
+              << "  --rastro ARQUIVO      grava cada tentativa de sentar em um rastro binário (ver\n"
+              << "                        ReproduzirRastro)\n"
+              << "  --metricas NOME       publica métricas ao vivo em memória compartilhada (/dev/shm/NOME),\n"
+              << "                        lidas por MetricasCadeiras no formato do Prometheus\n"
+              << "  --nos HOST:PORTA,...  coordena a partida com os jogadores divididos entre esses nós\n"
+              << "  --no PORTA            serve como nó de jogadores na porta UDP (até --partidas partidas)\n";
+}
 
-/*
- * Uso básico de um counting_semaphore em C++:
- * 
- * O `std::counting_semaphore` é um mecanismo de sincronização que permite controlar o acesso a um recurso compartilhado 
- * com um número máximo de acessos simultâneos. Neste projeto, ele é usado para gerenciar o número de cadeiras disponíveis.
- * Inicializamos o semáforo com `n - 1` para representar as cadeiras disponíveis no início do jogo. 
- * Cada jogador que tenta se sentar precisa fazer um `acquire()`, e o semáforo permite que até `n - 1` jogadores 
- * ocupem as cadeiras. Quando todos os assentos estão ocupados, jogadores adicionais ficam bloqueados até que 
- * o coordenador libere o semáforo com `release()`, sinalizando a eliminação dos jogadores.
- * O método `release()` também pode ser usado para liberar múltiplas permissões de uma só vez, por exemplo: `cadeira_sem.release(3);`,
- * o que permite destravar várias threads de uma só vez, como é feito na função `liberar_threads_eliminadas()`.
- *
- * Métodos da classe `std::counting_semaphore`:
- * 
- * 1. `acquire()`: Decrementa o contador do semáforo. Bloqueia a thread se o valor for zero.
- *    - Exemplo de uso: `cadeira_sem.acquire();` // Jogador tenta ocupar uma cadeira.
- * 
- * 2. `release(int n = 1)`: Incrementa o contador do semáforo em `n`. Pode liberar múltiplas permissões.
- *    - Exemplo de uso: `cadeira_sem.release(2);` // Libera 2 permissões simultaneamente.
- */
+// "K" remove K cadeiras por rodada; "P%" remove P% dos jogadores ativos (arredondado para cima)
+bool ler_remocao(const std::string &valor, RemocaoCadeiras &remocao){
+    long n = 0;
+    if (!valor.empty() && valor.back() == '%'){
+        if (!ler_inteiro(valor.substr(0, valor.size() - 1), 1, 99, n)) return false;
+        remocao.percentual = static_cast<int>(n);
+        return true;
+    }
+    if (!ler_inteiro(valor, 1, 100000000, n)) return false;
+    remocao.quantidade = static_cast<int>(n);
+    remocao.percentual = 0;
+    return true;
+}
 
-// Classes
-class JogoDasCadeiras
-{
-public:
-    JogoDasCadeiras(int num_jogadores)
-        : cadeiras(num_jogadores - 1) {}
+// Retorna false se algum argumento for inválido
+bool ler_configuracao(int argc, char **argv, Configuracao &config){
+    for (int i = 1; i < argc; ++i){
+        std::string arg = argv[i];
+        long n = 0;
 
-    void iniciar_rodada(int jogadores_ativos){
-        // TODO: Inicia uma nova rodada, removendo uma cadeira e ressincronizando o semáforo
-        cadeiras--;
-        numero_cadeira = 1;  // Reinicia a contagem de cadeiras ocupadas
-        
-        for (bool drenando = true; drenando; ) {
-            if (!cadeira_sem.try_acquire()) drenando = false;
+        if (!arg.empty() && arg[0] != '-'){
+            if (!ler_inteiro(arg, 2, 100000000, n)) return false;
+            config.num_jogadores = static_cast<int>(n);
+            continue;
         }
-        
-        cadeira_sem.release(cadeiras);
-        musica_parada.store(false); // Nova rodada
 
-        if (jogadores_ativos > 1){
-            std::cout << "\nPróxima rodada com " << jogadores_ativos << " jogadores e " << cadeiras << " cadeiras.\n" << "A música está tocando... 🎵\n\n";
+        if (arg == "--silencioso"){
+            config.silencioso = true;
+            continue;
         }
-    }
-
-    void parar_musica(){
-        // TODO: Simula o momento em que a música para e notifica os jogadores via variável de condição
-
-        { // bloqueio atomico
-            std::unique_lock<std::mutex> lock(music_mutex);
-            musica_parada.store(true, std::memory_order_release);
+        if (arg == "--simulado"){
+            config.simulado = true;
+            continue;
         }
-        
-        music_cv.notify_all(); //avisa que a musica parou
-        std::cout << "> A música parou! Os jogadores estão tentando se sentar...\n\n" << "----------------------------------------------------------\n";
-    }
-
-    void eliminar_jogador(int jogador_id, int num_jogadores) {
-        // TODO: Elimina um jogador que não conseguiu uma cadeira
-        std::lock_guard<std::mutex> lock(controle_mutex);
-        if(!eliminados[jogador_id - 1]) {
-            eliminados[jogador_id - 1] = true;
-            num_jogadores--;
+        if (arg == "--fixar"){
+            config.fixar_cpus = true;
+            continue;
         }
-    }
-
-    void exibir_estado(){
-        // TODO: Exibe o estado atual das cadeiras e dos jogadores
-        std::cout << "Rodada atual com " << cadeiras << " cadeiras disponíveis.\n";
-    }
-
-    bool jogo_ativo(int jogadores_ativos) const{
-        return jogadores_ativos > 1; //se tem mais de um entao ninguem ganhou ainda
-    }
-
-private:
-    int num_jogadores;
-    int cadeiras;
-    std::vector<bool> eliminados;
-    std::mutex controle_mutex;
-};
-
-class Jogador
-{
-public:
-    Jogador(int id)
-        : id(id), ativo(true), tentou_rodada(false) {}
-        
-    // Construtor de cópia
-    Jogador(const Jogador& other)
-        : id(other.id), ativo(other.ativo.load()), tentou_rodada(other.tentou_rodada.load()) {}
-
-    // Construtor de movimentação
-    Jogador(Jogador&& other) noexcept
-        : id(other.id), ativo(other.ativo.load()), tentou_rodada(other.tentou_rodada.load()) {}
-
-    bool esta_ativo() const{
-        return ativo;
-    }
-
-    int get_id() const{
-        return id;
-    }
-
-    void reseta_rodada(){
-        tentou_rodada = false;
-    }
-
-    void tentar_ocupar_cadeira(){
-        // TODO: Tenta ocupar uma cadeira utilizando o semáforo contador quando a música para (aguarda pela variável de condição)
-        // if (ativo && !tentou_rodada){
-        //     tentou_rodada = true; 
-        //     verificar_eliminacao();
-        // }
-        if (ativo.load(std::memory_order_acquire) && !tentou_rodada.exchange(true, std::memory_order_acq_rel)) {
-            verificar_eliminacao();
+        if (arg == "--instrumentar"){
+            config.instrumentar = true;
+            continue;
+        }
+        if (arg == "--largada"){
+            config.largada = true;
+            continue;
+        }
+        if (arg == "--inicio-rapido"){
+            config.inicio_rapido = true;
+            continue;
         }
-    }
 
-    void verificar_eliminacao(){
-        // TODO: Verifica se foi eliminado após ser destravado do semáforo
-        // if (cadeira_sem.try_acquire()){
-        //     std::cout << "[Cadeira " << numero_cadeira++ << "]: Ocupada por P" << id << "\n";
-        // } else { 
-        //     ativo = false; 
-        //     std::cout << "\nJogador P" << id << " não conseguiu uma cadeira e foi eliminado!\n";
-        //     std::cout << "----------------------------------------------------------\n";
-        // }
-        if (cadeira_sem.try_acquire()) {
-            std::lock_guard<std::mutex> cout_lock(cout_mutex);
-            std::cout << "[Cadeira " << numero_cadeira.fetch_add(1, std::memory_order_relaxed) + 1 << "]: Ocupada por P" << id << "\n";
+        if (i + 1 >= argc) return false;
+        std::string valor = argv[++i];
+
+        if (arg == "--jogadores" || arg == "-j"){
+            if (!ler_inteiro(valor, 2, 100000000, n)) return false;
+            config.num_jogadores = static_cast<int>(n);
+        } else if (arg == "--modo"){
+            if (!ler_modo(valor, config.modo)) return false;
+        } else if (arg == "--sinal"){
+            if (!ler_sinal(valor, config.sinal)) return false;
+        } else if (arg == "--cadeiras"){
+            if (!ler_estrategia(valor, config.estrategia)) return false;
+        } else if (arg == "--semente"){
+            if (!ler_semente(valor, config.semente)) return false;
+            config.tem_semente = true;
+        } else if (arg == "--musica"){
+            long maximo = 0;
+            if (i + 1 >= argc) return false;
+            if (!ler_inteiro(valor, 0, 3600000, n) || !ler_inteiro(argv[++i], n, 3600000, maximo)) return false;
+            config.musica_min_ms = static_cast<int>(n);
+            config.musica_max_ms = static_cast<int>(maximo);
+        } else if (arg == "--threads"){
+            if (!ler_inteiro(valor, 1, 4096, n)) return false;
+            config.num_threads = static_cast<unsigned>(n);
+        } else if (arg == "--max-rodadas"){
+            if (!ler_inteiro(valor, 0, 100000000, n)) return false;
+            config.max_rodadas = static_cast<int>(n);
+        } else if (arg == "--espera"){
+            if (!ler_inteiro(valor, 0, 3600000, n)) return false;
+            config.espera_ms = static_cast<int>(n);
+        } else if (arg == "--remover"){
+            if (!ler_remocao(valor, config.remocao)) return false;
+        } else if (arg == "--torneio"){
+            if (!ler_inteiro(valor, 2, 100000000, n)) return false;
+            config.jogadores_por_mesa = static_cast<int>(n);
+        } else if (arg == "--rastro"){
+            if (valor.empty()) return false;
+            config.arquivo_rastro = valor;
+        } else if (arg == "--metricas"){
+            if (valor.empty() || valor.find('/', 1) != std::string::npos) return false;
+            config.nome_metricas = valor;
+        } else if (arg == "--partidas"){
+            if (!ler_inteiro(valor, 1, 100000000, n)) return false;
+            config.partidas = static_cast<int>(n);
+        } else if (arg == "--nos"){
+            if (valor.empty()) return false;
+            config.nos_distribuidos = valor;
+        } else if (arg == "--no"){
+            if (!ler_inteiro(valor, 1, 65535, n)) return false;
+            config.porta_no = static_cast<int>(n);
         } else {
-            ativo.store(false, std::memory_order_release);
-            std::lock_guard<std::mutex> cout_lock(cout_mutex);
-            std::cout << "\nJogador P" << id << " não conseguiu uma cadeira e foi eliminado!\n" << "----------------------------------------------------------\n";
+            return false;
         }
     }
+    // O modo distribuído não tem torneio nem rastro, e um processo é coordenador ou nó
+    const bool distribuido = !config.nos_distribuidos.empty() || config.porta_no > 0;
+    if (distribuido && (config.jogadores_por_mesa > 0 || !config.arquivo_rastro.empty())) return false;
+    return config.nos_distribuidos.empty() || config.porta_no == 0;
+}
 
-    void joga(){
-        //  while (ativo && jogo_ativo.load()){  // Verifica se o jogo ainda está ativo
-        //     std::unique_lock<std::mutex> lock(music_mutex);
-        //     music_cv.wait(lock, [] { return musica_parada.load() || !jogo_ativo.load(); });
-
-        //     if (!jogo_ativo.load()) break;  // Termina a execução se o jogo acabou
+// As mensagens de milhares de mesas simultâneas não seriam legíveis: só o resumo é exibido
+int executar_torneio(Motor &motor, const Configuracao &config){
+    const bool ativo = Motor::mensagens_ativas();
+    Motor::set_mensagens(false);
+
+    [[maybe_unused]] ResultadoTorneio resultado = motor.executar_torneio(config);
+
+    Motor::set_mensagens(ativo);
+    REGISTRAR("Torneio com %d jogadores em mesas de %d: %zu mesas em %d níveis, %llu rodadas\n"
+              "%.3f s com %u threads (%.0f mesas/s, %llu tarefas roubadas)\n"
+              "\n🏆 Campeão: Jogador P%d! 🏆\n",
+              config.num_jogadores, config.jogadores_por_mesa, resultado.mesas, resultado.niveis,
+              static_cast<unsigned long long>(resultado.rodadas), resultado.segundos, resultado.threads,
+              resultado.mesas / resultado.segundos, static_cast<unsigned long long>(resultado.roubos),
+              resultado.campeao);
+    Motor::descarregar_mensagens();
+    return 0;
+}
 
-        //     tentar_ocupar_cadeira();
-        // }
-        while (ativo.load(std::memory_order_acquire) && 
-              jogo_ativo.load(std::memory_order_acquire)) {
-            
-            std::unique_lock<std::mutex> lock(music_mutex);
-            music_cv.wait(lock, [this] { 
-                return musica_parada.load(std::memory_order_acquire) || 
-                      !jogo_ativo.load(std::memory_order_acquire); 
-            });
+// Com --sinal adaptativo, quantas esperas dos jogadores terminaram girando e quantas estacionaram
+void exibir_esperas(const Configuracao &config, [[maybe_unused]] std::uint64_t girando,
+                    [[maybe_unused]] std::uint64_t estacionadas){
+    if (config.sinal != TipoSinal::Adaptativo) return;
+    REGISTRAR("Esperas adaptativas: %llu girando, %llu estacionadas\n",
+              static_cast<unsigned long long>(girando), static_cast<unsigned long long>(estacionadas));
+}
 
-            if (!jogo_ativo.load(std::memory_order_acquire)) break;
+// Tempo da montagem da partida (memória, threads, nós) até a música da primeira rodada começar
+void exibir_inicio(const Configuracao &config, [[maybe_unused]] const ResultadoPartida &resultado){
+    if (!config.inicio_rapido && !config.instrumentar) return;
+    REGISTRAR("Tempo até a primeira rodada: %.3f ms\n", resultado.ate_primeira_rodada_ns / 1e6);
+}
 
-            tentar_ocupar_cadeira();
-        }
+// Partidas seguidas no mesmo motor: as threads ficam estacionadas entre uma e outra. Com
+// semente fixa, cada partida usa a semente seguinte para que não sejam todas iguais
+void executar_partidas(Motor &motor, Configuracao config, Rastro *rastro){
+    const auto inicio = std::chrono::steady_clock::now();
+    std::uint64_t girando = 0, estacionadas = 0;
+    for (int p = 0; p < config.partidas; ++p){
+        const ResultadoPartida &resultado = motor.executar_partida(config, rastro);
+        REGISTRAR("Partida %d: vencedor P%d em %d rodadas\n", p + 1, resultado.vencedor, resultado.rodadas);
+        if (p == 0) exibir_inicio(config, resultado); // as seguintes já encontram as threads e a arena
+        girando += resultado.esperas_girando;
+        estacionadas += resultado.esperas_estacionadas;
+        config.semente++;
     }
+    [[maybe_unused]] const double segundos = std::chrono::duration<double>(std::chrono::steady_clock::now() - inicio).count();
+    REGISTRAR("\n%d partidas em %.3f s (%.0f partidas/s), %zu threads criadas\n", config.partidas, segundos,
+              config.partidas / segundos, motor.get_threads_criadas());
+    exibir_esperas(config, girando, estacionadas);
+}
 
-private:
-    int id;
-    std::atomic<bool> ativo;
-    std::atomic<bool> tentou_rodada;
-};
-
-class Coordenador{
-public:
-    Coordenador(JogoDasCadeiras &jogo, std::vector<Jogador> &jogadores)
-        : jogo(jogo), jogadores(jogadores) {}
-
-    void iniciar_jogo(){
-        // TODO: Começa o jogo, dorme por um período aleatório, e então para a música, sinalizando os jogadores 
-        std::random_device rd;
-        std::mt19937 gen(rd());
-        std::uniform_int_distribution<> dist(1000, 3000);
-
-        while (jogo.jogo_ativo(jogadores_ativos())){
-            std::this_thread::sleep_for(std::chrono::milliseconds(dist(gen)));
-            jogo.parar_musica();
-
-            std::this_thread::sleep_for(std::chrono::milliseconds(1000));
-            liberar_threads_eliminadas();
-            jogo.iniciar_rodada(jogadores_ativos());
-            reseta_rodada_jogadores();
+// Partidas com os jogadores nos nós de --nos: o coordenador só troca uma mensagem por nó a cada rodada
+int executar_distribuidas(Motor &motor, Configuracao config){
+    ResultadoPartida resultado;
+    std::string erro;
+    for (int p = 0; p < config.partidas; ++p){
+        if (!motor.executar_distribuida(config, resultado, erro)){
+            Motor::descarregar_mensagens();
+            std::cerr << "Partida distribuída: " << erro << "\n";
+            return 1;
         }
-
-        std::cout << "\n🏆 Vencedor: Jogador P" << encontrar_vencedor() << "! Parabéns! 🏆\n\n";
-        std::cout << "----------------------------------------------------------\n";
-
-        jogo_ativo.store(false);
-        music_cv.notify_all();
+        if (config.partidas > 1){
+            REGISTRAR("Partida %d: vencedor P%d em %d rodadas\n", p + 1, resultado.vencedor, resultado.rodadas);
+        }
+        exibir_inicio(config, resultado);
+        config.semente++;
     }
+    Motor::descarregar_mensagens();
+    return 0;
+}
 
-    void liberar_threads_eliminadas(){
-        // Libera múltiplas permissões no semáforo para destravar todas as threads que não conseguiram se sentar
-        cadeira_sem.release(NUM_JOGADORES - 1); // Libera o número de permissões igual ao número de jogadores que ficaram esperando
+// Main function
+int main(int argc, char **argv){
+    Configuracao config;
+    if (!ler_configuracao(argc, argv, config)){
+        exibir_uso(argv[0]);
+        return 1;
     }
+    [[maybe_unused]] const int num_jogadores = config.num_jogadores;
 
-    int jogadores_ativos() const{
-        int ativos = 0;
-        for (const auto &jogador : jogadores){
-            if (jogador.esta_ativo()){
-                ativos++;
-            }
-        }
-        return ativos;
-    }
+    Motor motor;
+    Motor::set_mensagens(!config.silencioso);
 
-    int encontrar_vencedor() const{
-        for (const auto &jogador : jogadores){
-            if (jogador.esta_ativo()){
-                return jogador.get_id();
-            }
-        }
-        return -1;
+    std::string erro;
+    if (!config.nome_metricas.empty() && !Motor::abrir_metricas(config.nome_metricas, erro)){
+        std::cerr << "Não foi possível criar as métricas " << config.nome_metricas << ": " << erro << "\n";
+        return 1;
     }
 
-    void reseta_rodada_jogadores(){
-        for (auto &jogador : jogadores){
-            jogador.reseta_rodada();
-        }
+    if (config.jogadores_por_mesa > 0){
+        return executar_torneio(motor, config);
+    }
+    if (config.porta_no > 0){
+        const bool servido = Motor::servir_no(config, erro);
+        Motor::descarregar_mensagens();
+        if (!servido) std::cerr << "Nó na porta " << config.porta_no << ": " << erro << "\n";
+        return servido ? 0 : 1;
+    }
+    if (!config.nos_distribuidos.empty()){
+        return executar_distribuidas(motor, config);
     }
 
-private:
-    JogoDasCadeiras &jogo;
-    std::vector<Jogador> &jogadores;
-};
-
-// Main function
-int main(){
-    std::cout << "----------------------------------------------------------\n";
-    std::cout << "Bem-vindo ao Jogo das Cadeiras Concorrente!\n";
-    std::cout << "----------------------------------------------------------\n";
-
-    std::cout << "\nIniciando rodada com " << NUM_JOGADORES << " jogadores e " << NUM_JOGADORES - 1 << " cadeiras\n";
-    std::cout << "A música está tocando... 🎵\n\n";
+    REGISTRAR("----------------------------------------------------------\n"
+              "Bem-vindo ao Jogo das Cadeiras Concorrente!\n"
+              "----------------------------------------------------------\n");
 
-    JogoDasCadeiras jogo(NUM_JOGADORES);
-    std::vector<Jogador> jogadores;
+    REGISTRAR("\nIniciando rodada com %d jogadores e %d cadeiras\nA música está tocando... 🎵\n\n", num_jogadores,
+              config.remocao.cadeiras_para(num_jogadores));
 
-    // Criação das threads dos jogadores
-    for (int i = 1; i <= NUM_JOGADORES; ++i){
-        jogadores.emplace_back(i);
+    Rastro rastro;
+    if (!config.arquivo_rastro.empty() &&
+        !rastro.abrir(config.arquivo_rastro, Rastro::eventos_para(config) * static_cast<std::uint64_t>(config.partidas))){
+        std::cerr << "Não foi possível criar o rastro " << config.arquivo_rastro << ": " << rastro.erro() << "\n";
+        return 1;
     }
-
-    Coordenador coordenador(jogo, jogadores);
-    std::vector<std::thread> threads_jogadores;
-
-    for (auto &jogador : jogadores){
-        threads_jogadores.emplace_back(&Jogador::joga, &jogador);
+    Rastro *destino = rastro.aberto() ? &rastro : nullptr;
+
+    if (config.partidas == 1){
+        const ResultadoPartida &resultado = motor.executar_partida(config, destino);
+        exibir_esperas(config, resultado.esperas_girando, resultado.esperas_estacionadas);
+        exibir_inicio(config, resultado);
+    } else {
+        executar_partidas(motor, config, destino);
     }
-
-    // Thread do coordenador
-    std::thread thread_coordenador(&Coordenador::iniciar_jogo, &coordenador);
-
-    // Esperar pelas threads dos jogadores
-    for (auto &t : threads_jogadores) {
-        if (t.joinable()){
-            t.join();
-        }
+    if (!rastro.fechar()){
+        std::cerr << "Erro ao fechar o rastro " << config.arquivo_rastro << ": " << rastro.erro() << "\n";
+        return 1;
     }
 
-    // Esperar pela thread do coordenador
-    if (thread_coordenador.joinable()){
-        thread_coordenador.join();
-    }
+    REGISTRAR("\nObrigado por jogar o Jogo das Cadeiras Concorrente!\n\n");
+    Motor::descarregar_mensagens();
 
-    std::cout << "\nObrigado por jogar o Jogo das Cadeiras Concorrente!\n\n";
+    // Fora do registro: os histogramas saem mesmo com --silencioso
+    if (config.instrumentar){
+        std::cout << Motor::instrumentacao_json() << std::endl;
+    }
 
     return 0;
 }
@@ -0,0 +1,214 @@
+#pragma once
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <unistd.h>
+
+#include <atomic>
+#include <cerrno>
+#include <cstdint>
+#include <cstring>
+#include <new>
+#include <string>
+
+#include "disputas.hpp"
+#include "instrumentacao.hpp"
+#include "registro.hpp"
+
+/*
+ * Métricas ao vivo (`--metricas NOME`): um bloco em memória compartilhada (`shm_open`) que outro
+ * processo lê sem parar o jogo; `ferramentas/metricas_cadeiras.cpp` o converte para o formato de
+ * texto do Prometheus, uma vez ou servindo `/metrics` por HTTP.
+ *
+ * Nada disso fica no caminho dos jogadores. Os contadores vêm de onde já existem, todos por
+ * thread e escritos sem trava só pela thread dona: as `Disputas` que as cadeiras contam só quando
+ * há contenção e os histogramas da `Instrumentacao`. A instrumentação não é ligada pelas
+ * métricas (custa perto de 20% nas mesas pequenas de um torneio): o histograma de despertar só é
+ * preenchido junto com `--instrumentar`. Só o coordenador de cada partida escreve no bloco: ao fim de
+ * cada rodada soma as rodadas e os eliminados da rodada, e no máximo a cada
+ * `INTERVALO_PUBLICACAO_NS` um deles publica o que é caro de calcular: rodadas por segundo, as
+ * disputas e o histograma de despertar somados de todas as threads e a profundidade da fila do
+ * `Registro`.
+ *
+ * Vários coordenadores (as mesas de um torneio) escrevem ao mesmo tempo: os contadores são somas
+ * atômicas e a publicação é protegida por uma sequência ímpar/par (seqlock), que o leitor usa
+ * para não ver um histograma pela metade.
+ */
+inline constexpr char MAGICA_METRICAS[8] = {'J', 'D', 'C', 'M', 'E', 'T', 'R', 'I'};
+inline constexpr std::uint32_t VERSAO_METRICAS = 2;
+
+struct BlocoMetricas
+{
+    // Limites superiores do histograma de despertar: 2^PRIMEIRO_EXPOENTE ns, dobrando a cada balde
+    static constexpr unsigned NUM_BALDES = 20;
+    static constexpr unsigned PRIMEIRO_EXPOENTE = 8; // 256 ns ... ~134 ms
+
+    char magica[8]; // "JDCMETRI"
+    std::uint32_t versao;
+    std::uint32_t num_baldes;
+
+    // Somados pelos coordenadores a cada rodada
+    std::atomic<std::uint64_t> partidas;
+    std::atomic<std::uint64_t> rodadas;
+    std::atomic<std::int64_t> jogadores_ativos;  // somando todas as partidas em andamento
+
+    // Publicados pelo coordenador que ganhou a vez, sob `sequencia`
+    alignas(64) std::atomic<std::uint64_t> sequencia;
+    std::atomic<std::uint64_t> instante_ns;      // da última publicação (relógio monotônico)
+    std::atomic<std::uint64_t> rodadas_por_s_mili;
+    std::atomic<std::uint64_t> disputas;         // tentativas de sentar repetidas por contenção
+    std::atomic<std::uint64_t> fila_registro;
+    std::atomic<std::uint64_t> despertar_baldes[NUM_BALDES]; // contagens acumuladas, como no Prometheus
+    std::atomic<std::uint64_t> despertar_total;
+    std::atomic<std::uint64_t> despertar_soma_ns; // aproximada pelo limite inferior de cada balde
+
+    static std::uint64_t limite_balde(unsigned i){
+        return std::uint64_t{1} << (PRIMEIRO_EXPOENTE + i);
+    }
+};
+static_assert(std::atomic<std::uint64_t>::is_always_lock_free, "o bloco é lido por outro processo");
+
+class Metricas
+{
+public:
+    static Metricas& instancia(){
+        static Metricas metricas;
+        return metricas;
+    }
+
+    Metricas(const Metricas&) = delete;
+    Metricas& operator=(const Metricas&) = delete;
+
+    ~Metricas(){
+        fechar();
+    }
+
+    // Cria (ou recria) o bloco `/NOME` em /dev/shm; em caso de erro retorna false e `erro()`
+    // descreve o motivo. Chamado antes das partidas, sem nenhum coordenador rodando
+    bool abrir(const std::string &nome){
+        fechar();
+        const std::string caminho = nome_shm(nome);
+        const int descritor = ::shm_open(caminho.c_str(), O_RDWR | O_CREAT | O_TRUNC, 0644);
+        if (descritor < 0) return falhar("shm_open");
+        if (::ftruncate(descritor, sizeof(BlocoMetricas)) != 0){
+            const int erro_ftruncate = errno;
+            ::close(descritor);
+            errno = erro_ftruncate;
+            return falhar("ftruncate");
+        }
+        void *mapa = ::mmap(nullptr, sizeof(BlocoMetricas), PROT_READ | PROT_WRITE, MAP_SHARED, descritor, 0);
+        ::close(descritor);
+        if (mapa == MAP_FAILED) return falhar("mmap");
+
+        bloco = new (mapa) BlocoMetricas{};
+        std::memcpy(bloco->magica, MAGICA_METRICAS, sizeof(MAGICA_METRICAS));
+        bloco->versao = VERSAO_METRICAS;
+        bloco->num_baldes = BlocoMetricas::NUM_BALDES;
+        nome_aberto = caminho;
+        ultima_publicacao.store(0, std::memory_order_relaxed);
+        ativa.store(true, std::memory_order_release);
+        return true;
+    }
+
+    bool esta_ativa() const{
+        return ativa.load(std::memory_order_acquire);
+    }
+
+    // Desfaz o mapa e remove o bloco de /dev/shm
+    void fechar(){
+        if (!bloco) return;
+        ativa.store(false, std::memory_order_release);
+        ::munmap(bloco, sizeof(BlocoMetricas));
+        ::shm_unlink(nome_aberto.c_str());
+        bloco = nullptr;
+    }
+
+    const std::string& erro() const{
+        return mensagem_erro;
+    }
+
+    // Coordenador: uma partida com `jogadores` jogadores começou
+    void iniciar_partida(int jogadores){
+        bloco->jogadores_ativos.fetch_add(jogadores, std::memory_order_relaxed);
+    }
+
+    // Coordenador, ao fim de cada rodada, com os `eliminados` na rodada
+    void registrar_rodada(std::uint64_t agora, int eliminados){
+        bloco->rodadas.fetch_add(1, std::memory_order_relaxed);
+        bloco->jogadores_ativos.fetch_sub(eliminados, std::memory_order_relaxed);
+        publicar_se_vencido(agora);
+    }
+
+    // Coordenador, ao fim da partida, com os jogadores que sobraram (o vencedor)
+    void encerrar_partida(std::uint64_t agora, int restantes){
+        bloco->partidas.fetch_add(1, std::memory_order_relaxed);
+        bloco->jogadores_ativos.fetch_sub(restantes, std::memory_order_relaxed);
+        publicar_se_vencido(agora);
+    }
+
+    static std::string nome_shm(const std::string &nome){
+        return !nome.empty() && nome[0] == '/' ? nome : "/" + nome;
+    }
+
+private:
+    static constexpr std::uint64_t INTERVALO_PUBLICACAO_NS = 100'000'000;
+
+    Metricas() = default;
+
+    void publicar_se_vencido(std::uint64_t agora){
+        if (agora < ultima_publicacao.load(std::memory_order_relaxed) + INTERVALO_PUBLICACAO_NS) return;
+        publicar(agora);
+    }
+
+    // Fora de linha, para a cópia do histograma (4 KB na pilha) não pesar no laço do coordenador.
+    // Só um coordenador publica por vez; os outros seguem a partida sem esperar
+    [[gnu::noinline]] void publicar(std::uint64_t agora){
+        if (publicando.exchange(true, std::memory_order_acquire)) return;
+        const std::uint64_t anterior = ultima_publicacao.load(std::memory_order_relaxed);
+        if (agora < anterior + INTERVALO_PUBLICACAO_NS){
+            publicando.store(false, std::memory_order_release);
+            return;
+        }
+        ultima_publicacao.store(agora, std::memory_order_relaxed);
+
+        const std::uint64_t rodadas = bloco->rodadas.load(std::memory_order_relaxed);
+        const std::uint64_t disputas = Disputas::instancia().total();
+        const Histograma despertar = Instrumentacao::instancia().histograma(Metrica::Despertar);
+        const std::uint64_t fila = Registro::instancia().profundidade();
+
+        const std::uint64_t sequencia = bloco->sequencia.load(std::memory_order_relaxed);
+        bloco->sequencia.store(sequencia + 1, std::memory_order_relaxed); // ímpar: publicando
+        std::atomic_thread_fence(std::memory_order_release);
+
+        if (anterior != 0 && agora > anterior){
+            const double por_s = static_cast<double>(rodadas - rodadas_publicadas) * 1e9 / static_cast<double>(agora - anterior);
+            bloco->rodadas_por_s_mili.store(static_cast<std::uint64_t>(por_s * 1000.0), std::memory_order_relaxed);
+        }
+        rodadas_publicadas = rodadas;
+        bloco->disputas.store(disputas, std::memory_order_relaxed);
+        for (unsigned i = 0; i < BlocoMetricas::NUM_BALDES; ++i){
+            bloco->despertar_baldes[i].store(despertar.contagem_abaixo(BlocoMetricas::limite_balde(i)),
+                                             std::memory_order_relaxed);
+        }
+        bloco->despertar_total.store(despertar.total(), std::memory_order_relaxed);
+        bloco->despertar_soma_ns.store(despertar.soma_aproximada(), std::memory_order_relaxed);
+        bloco->fila_registro.store(fila, std::memory_order_relaxed);
+        bloco->instante_ns.store(agora, std::memory_order_relaxed);
+
+        bloco->sequencia.store(sequencia + 2, std::memory_order_release); // par: pronto
+        publicando.store(false, std::memory_order_release);
+    }
+
+    bool falhar(const char *operacao){
+        mensagem_erro = std::string(operacao) + ": " + std::strerror(errno);
+        return false;
+    }
+
+    BlocoMetricas *bloco = nullptr;
+    std::atomic<bool> ativa{false};
+    std::string nome_aberto;
+    std::string mensagem_erro;
+    alignas(64) std::atomic<std::uint64_t> ultima_publicacao{0};
+    std::atomic<bool> publicando{false};
+    std::uint64_t rodadas_publicadas = 0; // protegido por `publicando`
+};
@@ -0,0 +1,86 @@
+#include "motor.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <thread>
+
+#include "contexto_partida.hpp"
+#include "distribuido.hpp"
+#include "instrumentacao.hpp"
+#include "metricas.hpp"
+#include "pool_trabalho.hpp"
+#include "registro.hpp"
+#include "torneio.hpp"
+
+// Enquanto ninguém chamar set_mensagens, criar um motor desliga as mensagens: por padrão a
+// biblioteca não escreve nada na saída
+static std::atomic<bool> mensagens_escolhidas{false};
+
+struct Motor::Estado
+{
+    ContextoPartida contexto;
+    std::unique_ptr<PoolDeTrabalho> pool_torneio; // mantido entre torneios com as mesmas threads e fixação
+    bool pool_torneio_fixado = false;
+    CoordenadorDistribuido distribuido;           // socket e endereços dos nós, entre partidas
+};
+
+Motor::Motor()
+    : estado(std::make_unique<Estado>()){
+    if (!mensagens_escolhidas.load(std::memory_order_relaxed)){
+        Registro::instancia().set_ativo(false);
+    }
+}
+
+Motor::~Motor() = default;
+
+const ResultadoPartida& Motor::executar_partida(const Configuracao &config, Rastro *rastro){
+    return estado->contexto.executar(config, rastro);
+}
+
+ResultadoTorneio Motor::executar_torneio(const Configuracao &config){
+    const unsigned threads = std::max(1u, config.num_threads ? config.num_threads : std::thread::hardware_concurrency());
+    auto &pool = estado->pool_torneio;
+    if (!pool || pool->tamanho() != threads || estado->pool_torneio_fixado != config.fixar_cpus){
+        pool.reset();
+        pool = std::make_unique<PoolDeTrabalho>(threads, config.fixar_cpus);
+        estado->pool_torneio_fixado = config.fixar_cpus;
+    }
+    Torneio torneio(config, config.jogadores_por_mesa, *pool);
+    return torneio.executar();
+}
+
+bool Motor::executar_distribuida(const Configuracao &config, ResultadoPartida &resultado, std::string &erro){
+    return estado->distribuido.executar(config, resultado, erro);
+}
+
+bool Motor::servir_no(const Configuracao &config, std::string &erro){
+    NoJogadores no;
+    return no.servir(config, erro);
+}
+
+std::size_t Motor::get_threads_criadas() const{
+    return estado->contexto.get_threads_criadas();
+}
+
+void Motor::set_mensagens(bool ativas){
+    mensagens_escolhidas.store(true, std::memory_order_relaxed);
+    Registro::instancia().set_ativo(ativas);
+}
+
+bool Motor::mensagens_ativas(){
+    return Registro::instancia().esta_ativo();
+}
+
+void Motor::descarregar_mensagens(){
+    Registro::instancia().descarregar();
+}
+
+std::string Motor::instrumentacao_json(){
+    return Instrumentacao::instancia().para_json();
+}
+
+bool Motor::abrir_metricas(const std::string &nome, std::string &erro){
+    if (Metricas::instancia().abrir(nome)) return true;
+    erro = Metricas::instancia().erro();
+    return false;
+}
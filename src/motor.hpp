@@ -0,0 +1,68 @@
+#pragma once
+
+#include <cstddef>
+#include <memory>
+#include <string>
+
+#include "configuracao.hpp"
+#include "resultado.hpp"
+
+class Rastro;
+
+/*
+ * Interface da biblioteca MotorCadeiras: o jogo completo (estratégias de cadeiras, coordenador,
+ * modos de execução, torneio, modo distribuído) atrás de uma classe, sem saída em texto obrigatória.
+ *
+ * Quem usa a biblioteca inclui só este cabeçalho e liga com o alvo CMake `MotorCadeiras`, mais
+ * `rastro.hpp` para gravar um rastro e `registro.hpp` para escrever junto com as mensagens do
+ * jogo; o resto de `src/` é implementação. Um `Motor` guarda
+ * entre partidas a arena, as threads estacionadas e o pool (`ContextoPartida`), então partidas
+ * seguidas pelo mesmo objeto não pagam criação de threads nem alocações. Um `Motor` não deve ser
+ * usado por duas threads ao mesmo tempo; vários motores podem rodar em paralelo.
+ *
+ * As mensagens do jogo (`Registro`) ficam desligadas para quem usa a biblioteca, a menos que
+ * `set_mensagens(true)` seja chamado, como faz o executável JogoDasCadeiras.
+ */
+class Motor
+{
+public:
+    Motor();
+    ~Motor();
+
+    Motor(const Motor&) = delete;
+    Motor& operator=(const Motor&) = delete;
+
+    // Executa uma partida completa; o resultado vale até a próxima chamada
+    const ResultadoPartida& executar_partida(const Configuracao &config, Rastro *rastro = nullptr);
+
+    // Torneio em mesas de `config.jogadores_por_mesa` jogadores, no pool de `config.num_threads`
+    // threads (0 = hardware_concurrency()); as mesas rodam sempre no modo simulado
+    ResultadoTorneio executar_torneio(const Configuracao &config);
+
+    // Partida com os jogadores divididos entre os nós de `config.nos_distribuidos`, cada um
+    // servindo com `servir_no`; false com o motivo em `erro` se um nó não responde
+    bool executar_distribuida(const Configuracao &config, ResultadoPartida &resultado, std::string &erro);
+
+    // Serve fragmentos de jogadores na porta UDP `config.porta_no` até `config.partidas`
+    // partidas terminarem; false com o motivo em `erro` se a porta não pode ser aberta
+    static bool servir_no(const Configuracao &config, std::string &erro);
+
+    // Threads de coordenador e jogadores criadas por este motor até agora
+    std::size_t get_threads_criadas() const;
+
+    static void set_mensagens(bool ativas);
+    static bool mensagens_ativas();
+    // Espera todas as mensagens registradas até aqui serem escritas
+    static void descarregar_mensagens();
+
+    // Histogramas de latência (`Configuracao::instrumentar`) de todas as threads, em JSON
+    static std::string instrumentacao_json();
+
+    // Passa a publicar métricas ao vivo de todos os motores em /dev/shm/NOME (`metricas.hpp`),
+    // até o fim do processo; em caso de erro retorna false com o motivo em `erro`
+    static bool abrir_metricas(const std::string &nome, std::string &erro);
+
+private:
+    struct Estado;
+    std::unique_ptr<Estado> estado;
+};
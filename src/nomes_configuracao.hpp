@@ -0,0 +1,103 @@
+#pragma once
+
+#include <cstdint>
+#include <cstdlib>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "configuracao.hpp"
+
+// Nomes das opções de `Configuracao` na linha de comando e no JSON, nos dois sentidos: usados pelo
+// jogo, pelo benchmark e pelo teste de estresse, para que todos aceitem e escrevam os mesmos nomes
+
+inline const char* nome_estrategia(EstrategiaCadeiras estrategia){
+    switch (estrategia){
+        case EstrategiaCadeiras::Semaforo: return "semaforo";
+        case EstrategiaCadeiras::Contador: return "contador";
+        case EstrategiaCadeiras::Vetor: return "vetor";
+        case EstrategiaCadeiras::PorNo: return "numa";
+        case EstrategiaCadeiras::Hierarquico: return "hierarquico";
+    }
+    return "?";
+}
+
+// O modo simulado não é um `ModoExecucao`, mas aparece como um modo nos resultados
+inline const char* nome_modo(ModoExecucao modo, bool simulado = false){
+    if (simulado) return "simulado";
+    switch (modo){
+        case ModoExecucao::Threads: return "threads";
+        case ModoExecucao::Pool: return "pool";
+        case ModoExecucao::Corrotina: return "corrotina";
+    }
+    return "?";
+}
+
+inline const char* nome_sinal(TipoSinal sinal){
+    switch (sinal){
+        case TipoSinal::VariavelCondicao: return "cv";
+        case TipoSinal::Atomico: return "atomico";
+        case TipoSinal::Adaptativo: return "adaptativo";
+    }
+    return "?";
+}
+
+inline bool ler_estrategia(const std::string &valor, EstrategiaCadeiras &saida){
+    for (EstrategiaCadeiras estrategia : {EstrategiaCadeiras::Semaforo, EstrategiaCadeiras::Contador, EstrategiaCadeiras::Vetor,
+                                          EstrategiaCadeiras::PorNo, EstrategiaCadeiras::Hierarquico}){
+        if (valor == nome_estrategia(estrategia)){
+            saida = estrategia;
+            return true;
+        }
+    }
+    return false;
+}
+
+inline bool ler_modo(const std::string &valor, ModoExecucao &saida){
+    for (ModoExecucao modo : {ModoExecucao::Threads, ModoExecucao::Pool, ModoExecucao::Corrotina}){
+        if (valor == nome_modo(modo)){
+            saida = modo;
+            return true;
+        }
+    }
+    return false;
+}
+
+inline bool ler_sinal(const std::string &valor, TipoSinal &saida){
+    for (TipoSinal sinal : {TipoSinal::VariavelCondicao, TipoSinal::Atomico, TipoSinal::Adaptativo}){
+        if (valor == nome_sinal(sinal)){
+            saida = sinal;
+            return true;
+        }
+    }
+    return false;
+}
+
+// Lista separada por vírgulas ("semaforo,vetor"); false se algum nome for inválido ou a lista vazia
+inline bool ler_estrategias(const std::string &valor, std::vector<EstrategiaCadeiras> &saida){
+    saida.clear();
+    std::stringstream ss(valor);
+    std::string item;
+    while (std::getline(ss, item, ',')){
+        EstrategiaCadeiras estrategia{};
+        if (!ler_estrategia(item, estrategia)) return false;
+        saida.push_back(estrategia);
+    }
+    return !saida.empty();
+}
+
+inline bool ler_inteiro(const std::string &valor, long minimo, long maximo, long &saida){
+    char *fim = nullptr;
+    long n = std::strtol(valor.c_str(), &fim, 10);
+    if (fim == valor.c_str() || *fim != '\0' || n < minimo || n > maximo) return false;
+    saida = n;
+    return true;
+}
+
+inline bool ler_semente(const std::string &valor, std::uint64_t &saida){
+    char *fim = nullptr;
+    const std::uint64_t n = std::strtoull(valor.c_str(), &fim, 10);
+    if (fim == valor.c_str() || *fim != '\0') return false;
+    saida = n;
+    return true;
+}
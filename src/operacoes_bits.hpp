@@ -0,0 +1,193 @@
+#pragma once
+
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+
+#if defined(__x86_64__) && defined(__GNUC__)
+#include <immintrin.h>
+#define OPERACOES_BITS_X86 1
+#endif
+
+/*
+ * Operações em massa sobre as palavras de bits da `TabelaJogadores`: zerar (as tentativas da
+ * rodada) e `a & ~b` com a contagem do resultado (quem tentou sentar e não está mais ativo: a
+ * máscara e o número de eliminados da rodada).
+ *
+ * Cada operação tem uma versão escalar, uma AVX2 (4 palavras por instrução) e uma AVX-512
+ * (8 palavras), compiladas com `__attribute__((target))` sem exigir `-mavx2` do resto do
+ * programa. `atual()` escolhe uma vez, pela CPU, a mais larga disponível; fora do x86 só existe
+ * a escalar. A contagem vetorial usa a tabela de 4 bits com `pshufb` e soma os bytes com `psadbw`,
+ * que não depende de `vpopcntq` (ausente em boa parte das CPUs com AVX-512).
+ *
+ * Os acessos são simples, não atômicos: só valem quando nenhum jogador lê ou escreve as palavras
+ * ao mesmo tempo (veja `TabelaJogadores::limpar_tentativas`).
+ */
+enum class ConjuntoInstrucoes { Escalar, Avx2, Avx512 };
+
+class OperacoesBits
+{
+public:
+    using Zerar = void (*)(std::uint64_t*, std::size_t);
+    using Diferenca = std::size_t (*)(std::uint64_t*, const std::uint64_t*, const std::uint64_t*, std::size_t);
+
+    // A versão mais larga que a CPU suporta, escolhida na primeira chamada
+    static const OperacoesBits& atual(){
+        static const OperacoesBits operacoes = para(melhor_suportado());
+        return operacoes;
+    }
+
+    // Uma versão específica (benchmark); a escalar se a CPU não suporta a pedida
+    static OperacoesBits para(ConjuntoInstrucoes conjunto){
+        if (!suporta(conjunto)) conjunto = ConjuntoInstrucoes::Escalar;
+        switch (conjunto){
+#ifdef OPERACOES_BITS_X86
+            case ConjuntoInstrucoes::Avx512: return {conjunto, zerar_avx512, diferenca_avx512};
+            case ConjuntoInstrucoes::Avx2: return {conjunto, zerar_avx2, diferenca_avx2};
+#endif
+            default: return {ConjuntoInstrucoes::Escalar, zerar_escalar, diferenca_escalar};
+        }
+    }
+
+    static bool suporta(ConjuntoInstrucoes conjunto){
+        switch (conjunto){
+            case ConjuntoInstrucoes::Escalar: return true;
+#ifdef OPERACOES_BITS_X86
+            case ConjuntoInstrucoes::Avx2:
+                __builtin_cpu_init();
+                return __builtin_cpu_supports("avx2");
+            case ConjuntoInstrucoes::Avx512:
+                __builtin_cpu_init();
+                return __builtin_cpu_supports("avx512f") && __builtin_cpu_supports("avx512bw");
+#endif
+            default: return false;
+        }
+    }
+
+    static const char* nome(ConjuntoInstrucoes conjunto){
+        switch (conjunto){
+            case ConjuntoInstrucoes::Escalar: return "escalar";
+            case ConjuntoInstrucoes::Avx2: return "avx2";
+            case ConjuntoInstrucoes::Avx512: return "avx512";
+        }
+        return "?";
+    }
+
+    void zerar(std::uint64_t *palavras, std::size_t n) const{
+        zerar_(palavras, n);
+    }
+
+    // saida[i] = a[i] & ~b[i]; retorna quantos bits ficaram ligados em `saida`
+    std::size_t diferenca(std::uint64_t *saida, const std::uint64_t *a, const std::uint64_t *b, std::size_t n) const{
+        return diferenca_(saida, a, b, n);
+    }
+
+    ConjuntoInstrucoes get_conjunto() const{
+        return conjunto;
+    }
+
+private:
+    OperacoesBits(ConjuntoInstrucoes conjunto, Zerar zerar, Diferenca diferenca)
+        : conjunto(conjunto), zerar_(zerar), diferenca_(diferenca) {}
+
+    static ConjuntoInstrucoes melhor_suportado(){
+        if (suporta(ConjuntoInstrucoes::Avx512)) return ConjuntoInstrucoes::Avx512;
+        if (suporta(ConjuntoInstrucoes::Avx2)) return ConjuntoInstrucoes::Avx2;
+        return ConjuntoInstrucoes::Escalar;
+    }
+
+    static void zerar_escalar(std::uint64_t *palavras, std::size_t n){
+        for (std::size_t i = 0; i < n; ++i){
+            palavras[i] = 0;
+        }
+    }
+
+    static std::size_t diferenca_escalar(std::uint64_t *saida, const std::uint64_t *a, const std::uint64_t *b, std::size_t n){
+        std::size_t total = 0;
+        for (std::size_t i = 0; i < n; ++i){
+            saida[i] = a[i] & ~b[i];
+            total += static_cast<std::size_t>(std::popcount(saida[i]));
+        }
+        return total;
+    }
+
+#ifdef OPERACOES_BITS_X86
+    // Bits ligados em cada byte de `v`, somados em 4 contadores de 64 bits
+    __attribute__((target("avx2"))) static __m256i contar_bytes_avx2(__m256i v){
+        const __m256i tabela = _mm256_setr_epi8(0, 1, 1, 2, 1, 2, 2, 3, 1, 2, 2, 3, 2, 3, 3, 4,
+                                                0, 1, 1, 2, 1, 2, 2, 3, 1, 2, 2, 3, 2, 3, 3, 4);
+        const __m256i nibble = _mm256_set1_epi8(0x0f);
+        const __m256i baixo = _mm256_shuffle_epi8(tabela, _mm256_and_si256(v, nibble));
+        const __m256i alto = _mm256_shuffle_epi8(tabela, _mm256_and_si256(_mm256_srli_epi16(v, 4), nibble));
+        return _mm256_sad_epu8(_mm256_add_epi8(baixo, alto), _mm256_setzero_si256());
+    }
+
+    __attribute__((target("avx2"))) static std::size_t somar_avx2(__m256i soma){
+        const __m128i metades = _mm_add_epi64(_mm256_castsi256_si128(soma), _mm256_extracti128_si256(soma, 1));
+        return static_cast<std::size_t>(_mm_cvtsi128_si64(metades) + _mm_extract_epi64(metades, 1));
+    }
+
+    __attribute__((target("avx2"))) static void zerar_avx2(std::uint64_t *palavras, std::size_t n){
+        std::size_t i = 0;
+        for (; i + 4 <= n; i += 4){
+            _mm256_storeu_si256(reinterpret_cast<__m256i*>(palavras + i), _mm256_setzero_si256());
+        }
+        zerar_escalar(palavras + i, n - i);
+    }
+
+    __attribute__((target("avx2"))) static std::size_t diferenca_avx2(std::uint64_t *saida, const std::uint64_t *a,
+                                                                     const std::uint64_t *b, std::size_t n){
+        __m256i soma = _mm256_setzero_si256();
+        std::size_t i = 0;
+        for (; i + 4 <= n; i += 4){
+            const __m256i va = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(a + i));
+            const __m256i vb = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(b + i));
+            const __m256i resto = _mm256_andnot_si256(vb, va);
+            _mm256_storeu_si256(reinterpret_cast<__m256i*>(saida + i), resto);
+            soma = _mm256_add_epi64(soma, contar_bytes_avx2(resto));
+        }
+        return somar_avx2(soma) + diferenca_escalar(saida + i, a + i, b + i, n - i);
+    }
+
+    // Sem `_mm512_broadcast_i32x4`, `_mm512_andnot_si512` e `_mm512_reduce_add_epi64`: no GCC 12
+    // eles partem de `_mm512_undefined_*` e geram -Wuninitialized com otimização
+    __attribute__((target("avx512f,avx512bw"))) static __m512i contar_bytes_avx512(__m512i v){
+        const __m512i tabela = _mm512_set4_epi32(0x04030302, 0x03020201, 0x03020201, 0x02010100); // bytes 0 1 1 2 ...
+        const __m512i nibble = _mm512_set1_epi8(0x0f);
+        const __m512i baixo = _mm512_shuffle_epi8(tabela, _mm512_and_si512(v, nibble));
+        const __m512i alto = _mm512_shuffle_epi8(tabela, _mm512_and_si512(_mm512_srli_epi16(v, 4), nibble));
+        return _mm512_sad_epu8(_mm512_add_epi8(baixo, alto), _mm512_setzero_si512());
+    }
+
+    __attribute__((target("avx512f"))) static void zerar_avx512(std::uint64_t *palavras, std::size_t n){
+        std::size_t i = 0;
+        for (; i + 8 <= n; i += 8){
+            _mm512_storeu_si512(palavras + i, _mm512_setzero_si512());
+        }
+        zerar_escalar(palavras + i, n - i);
+    }
+
+    __attribute__((target("avx512f,avx512bw"))) static std::size_t diferenca_avx512(std::uint64_t *saida, const std::uint64_t *a,
+                                                                                   const std::uint64_t *b, std::size_t n){
+        __m512i soma = _mm512_setzero_si512();
+        std::size_t i = 0;
+        for (; i + 8 <= n; i += 8){
+            const __m512i va = _mm512_loadu_si512(a + i);
+            const __m512i resto = _mm512_xor_si512(va, _mm512_and_si512(va, _mm512_loadu_si512(b + i))); // a & ~b
+            _mm512_storeu_si512(saida + i, resto);
+            soma = _mm512_add_epi64(soma, contar_bytes_avx512(resto));
+        }
+        alignas(64) std::uint64_t parciais[8];
+        _mm512_store_si512(parciais, soma);
+        std::size_t total = 0;
+        for (std::uint64_t parcial : parciais){
+            total += static_cast<std::size_t>(parcial);
+        }
+        return total + diferenca_escalar(saida + i, a + i, b + i, n - i);
+    }
+#endif
+
+    ConjuntoInstrucoes conjunto;
+    Zerar zerar_;
+    Diferenca diferenca_;
+};
@@ -0,0 +1,186 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <concepts>
+#include <cstdint>
+#include <memory_resource>
+#include <semaphore>
+
+#include "configuracao.hpp"
+#include "contador_cadeiras.hpp"
+#include "vetor_cadeiras.hpp"
+#include "cadeiras_por_no.hpp"
+#include "contador_hierarquico.hpp"
+#include "topologia.hpp"
+#include "registro.hpp"
+
+/*
+ * Políticas de cadeiras: o parâmetro de `JogoDasCadeiras<Politica>`.
+ *
+ * Cada estratégia de `EstrategiaCadeiras` é uma classe com a mesma interface (`ocupar`,
+ * `nova_rodada`, `exibir_ocupantes`), e o jogo, os jogadores e o coordenador são
+ * instanciados para uma delas. Assim `ocupar` é chamado direto e pode ser inlinado em
+ * `Jogador::verificar_eliminacao`, sem testar a estratégia a cada tentativa, e o jogo só guarda
+ * (e só aloca) a estrutura da estratégia escolhida. `com_politica` faz a escolha em tempo de
+ * execução, uma vez por partida.
+ */
+template <typename P>
+concept PoliticaCadeiras = requires(P politica, int jogador_id, std::uint32_t cadeiras) {
+    { politica.ocupar(jogador_id) } -> std::same_as<int>; // cadeira a partir de 1, 0 = eliminado
+    politica.nova_rodada(cadeiras);
+    politica.exibir_ocupantes();
+    { P::estrategia } -> std::convertible_to<EstrategiaCadeiras>;
+};
+
+// O jogo original: um counting_semaphore drenado e reabastecido a cada rodada
+class PoliticaSemaforo
+{
+public:
+    static constexpr EstrategiaCadeiras estrategia = EstrategiaCadeiras::Semaforo;
+
+    PoliticaSemaforo(std::uint32_t cadeiras, std::pmr::memory_resource*)
+        : cadeira_sem(cadeiras), cadeiras(cadeiras) {}
+
+    // try_acquire: quem não consegue cadeira é eliminado na hora, ninguém fica parado no semáforo
+    int ocupar(int){
+        if (cadeira_sem.try_acquire()){
+            return numero_cadeira.fetch_add(1, std::memory_order_relaxed);
+        }
+        return 0;
+    }
+
+    // Chamado com todos os jogadores da rodada anterior fora de `ocupar`: as permissões que
+    // sobraram são exatamente as cadeiras que ninguém ocupou (nenhuma, numa rodada completa),
+    // e só elas são drenadas
+    void nova_rodada(std::uint32_t novas_cadeiras){
+        const std::uint32_t ocupadas = static_cast<std::uint32_t>(numero_cadeira.load(std::memory_order_relaxed) - 1);
+        for (std::uint32_t sobra = cadeiras - std::min(ocupadas, cadeiras); sobra > 0 && cadeira_sem.try_acquire(); --sobra) {}
+
+        numero_cadeira.store(1);  // Reinicia a contagem de cadeiras ocupadas
+        cadeiras = novas_cadeiras;
+        cadeira_sem.release(novas_cadeiras);
+    }
+
+    void exibir_ocupantes() const {}
+
+private:
+    std::counting_semaphore<> cadeira_sem; // Inicia com n-1 cadeiras
+    std::uint32_t cadeiras;                // permissões liberadas na rodada atual
+    std::atomic<int> numero_cadeira{1};
+};
+
+class PoliticaContador
+{
+public:
+    static constexpr EstrategiaCadeiras estrategia = EstrategiaCadeiras::Contador;
+
+    PoliticaContador(std::uint32_t cadeiras, std::pmr::memory_resource*)
+        : contador(cadeiras) {}
+
+    int ocupar(int){
+        return static_cast<int>(contador.ocupar() + 1);
+    }
+
+    void nova_rodada(std::uint32_t cadeiras){
+        contador.nova_rodada(cadeiras); // um único store
+    }
+
+    void exibir_ocupantes() const {}
+
+private:
+    ContadorCadeiras contador;
+};
+
+class PoliticaVetor
+{
+public:
+    static constexpr EstrategiaCadeiras estrategia = EstrategiaCadeiras::Vetor;
+
+    PoliticaVetor(std::uint32_t cadeiras, std::pmr::memory_resource *recurso)
+        : vetor(cadeiras, recurso) {}
+
+    int ocupar(int jogador_id){
+        return static_cast<int>(vetor.ocupar(static_cast<std::uint32_t>(jogador_id)) + 1);
+    }
+
+    void nova_rodada(std::uint32_t cadeiras){
+        vetor.nova_rodada(cadeiras); // slots da rodada anterior ficam livres
+    }
+
+    // Só o vetor de cadeiras sabe quem sentou onde
+    void exibir_ocupantes() const{
+        for (std::uint32_t i = 0; i < vetor.capacidade(); ++i){
+            if (vetor.ocupante(i) != 0){
+                REGISTRAR("[Cadeira %u]: Ocupada por P%u\n", i + 1, vetor.ocupante(i));
+            } else {
+                REGISTRAR("[Cadeira %u]: Vazia\n", i + 1);
+            }
+        }
+    }
+
+private:
+    VetorCadeiras vetor;
+};
+
+class PoliticaPorNo
+{
+public:
+    static constexpr EstrategiaCadeiras estrategia = EstrategiaCadeiras::PorNo;
+
+    PoliticaPorNo(std::uint32_t cadeiras, std::pmr::memory_resource *recurso)
+        : por_no(cadeiras, Topologia::sistema().num_nos(), recurso) {}
+
+    int ocupar(int){
+        return static_cast<int>(por_no.ocupar(Topologia::sistema().no_atual()) + 1);
+    }
+
+    void nova_rodada(std::uint32_t cadeiras){
+        por_no.nova_rodada(cadeiras); // um store por nó
+    }
+
+    void exibir_ocupantes() const {}
+
+private:
+    CadeirasPorNo por_no;
+};
+
+class PoliticaHierarquica
+{
+public:
+    static constexpr EstrategiaCadeiras estrategia = EstrategiaCadeiras::Hierarquico;
+
+    PoliticaHierarquica(std::uint32_t cadeiras, std::pmr::memory_resource *recurso)
+        : hierarquico(cadeiras, std::min(64u, Topologia::sistema().num_cpus()), recurso) {}
+
+    int ocupar(int){
+        return static_cast<int>(hierarquico.ocupar() + 1);
+    }
+
+    void nova_rodada(std::uint32_t cadeiras){
+        hierarquico.nova_rodada(cadeiras); // zera os fragmentos
+    }
+
+    void exibir_ocupantes() const {}
+
+private:
+    ContadorHierarquico hierarquico;
+};
+
+// Chama `funcao.template operator()<Politica>()` com a política da estratégia escolhida e
+// devolve o seu resultado: o único ponto em que a estratégia é testada em tempo de execução
+template <typename Funcao>
+decltype(auto) com_politica(EstrategiaCadeiras estrategia, Funcao &&funcao){
+    switch (estrategia){
+        case EstrategiaCadeiras::Contador: return funcao.template operator()<PoliticaContador>();
+        case EstrategiaCadeiras::Vetor: return funcao.template operator()<PoliticaVetor>();
+        case EstrategiaCadeiras::PorNo: return funcao.template operator()<PoliticaPorNo>();
+        case EstrategiaCadeiras::Hierarquico: return funcao.template operator()<PoliticaHierarquica>();
+        case EstrategiaCadeiras::Semaforo: break;
+    }
+    return funcao.template operator()<PoliticaSemaforo>();
+}
+
+static_assert(PoliticaCadeiras<PoliticaSemaforo> && PoliticaCadeiras<PoliticaContador> &&
+              PoliticaCadeiras<PoliticaVetor> && PoliticaCadeiras<PoliticaPorNo> &&
+              PoliticaCadeiras<PoliticaHierarquica>);
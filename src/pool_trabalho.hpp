@@ -0,0 +1,175 @@
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "topologia.hpp"
+
+/*
+ * Pool fixo de threads trabalhadoras com roubo de tarefas.
+ *
+ * No modo "pool" os jogadores não têm thread própria: quando a música para, o coordenador
+ * divide os jogadores em blocos e submete cada bloco como uma tarefa. O número de threads
+ * fica limitado a `hardware_concurrency()`, independente do número de jogadores.
+ *
+ * Cada trabalhadora tem sua própria fila. Tarefas submetidas por uma trabalhadora (por exemplo,
+ * a próxima mesa de um torneio) vão para a fila dela e são retiradas do fim (LIFO, dados ainda
+ * quentes no cache); tarefas de fora são distribuídas em rodízio. Uma trabalhadora sem trabalho
+ * rouba do início da fila das outras antes de dormir.
+ *
+ * Com `fixar_cpus`, a trabalhadora i fica presa à i-ésima CPU de `Topologia::cpus_em_ordem()`,
+ * então as trabalhadoras de índices vizinhos dividem o mesmo nó NUMA.
+ */
+class PoolDeTrabalho
+{
+public:
+    explicit PoolDeTrabalho(unsigned num_threads = std::thread::hardware_concurrency(), bool fixar_cpus = false){
+        if (num_threads == 0) num_threads = 1;
+        filas.reserve(num_threads);
+        for (unsigned i = 0; i < num_threads; ++i){
+            filas.push_back(std::make_unique<Fila>());
+        }
+        trabalhadores.reserve(num_threads);
+        for (unsigned i = 0; i < num_threads; ++i){
+            trabalhadores.emplace_back(&PoolDeTrabalho::executa, this, i);
+            if (fixar_cpus){
+                Topologia::fixar(trabalhadores.back().native_handle(), Topologia::sistema().cpu_para(i));
+            }
+        }
+    }
+
+    PoolDeTrabalho(const PoolDeTrabalho&) = delete;
+    PoolDeTrabalho& operator=(const PoolDeTrabalho&) = delete;
+
+    ~PoolDeTrabalho(){
+        {
+            std::lock_guard<std::mutex> lock(dormir_mutex);
+            encerrando.store(true, std::memory_order_seq_cst);
+        }
+        dormir_cv.notify_all();
+        for (auto &t : trabalhadores){
+            if (t.joinable()){
+                t.join();
+            }
+        }
+    }
+
+    void submeter(std::function<void()> tarefa){
+        pendentes.fetch_add(1, std::memory_order_seq_cst);
+        enfileiradas.fetch_add(1, std::memory_order_seq_cst); // antes do push: nunca fica negativo
+
+        const unsigned destino = (pool_atual == this)
+            ? indice_atual
+            : static_cast<unsigned>(proxima_fila.fetch_add(1, std::memory_order_relaxed) % filas.size());
+        {
+            std::lock_guard<std::mutex> lock(filas[destino]->mutex);
+            filas[destino]->tarefas.push_back(std::move(tarefa));
+        }
+
+        if (dormindo.load(std::memory_order_seq_cst) > 0){
+            std::lock_guard<std::mutex> lock(dormir_mutex);
+            dormir_cv.notify_one();
+        }
+    }
+
+    // Bloqueia até que todas as tarefas submetidas tenham terminado
+    void aguardar(){
+        std::unique_lock<std::mutex> lock(ocioso_mutex);
+        ocioso_cv.wait(lock, [this] { return pendentes.load(std::memory_order_acquire) == 0; });
+    }
+
+    unsigned tamanho() const{
+        return static_cast<unsigned>(trabalhadores.size());
+    }
+
+    // Índice da trabalhadora que está executando a chamada, ou -1 fora do pool
+    int trabalhadora_atual() const{
+        return pool_atual == this ? static_cast<int>(indice_atual) : -1;
+    }
+
+    std::uint64_t get_roubos() const{
+        return roubos.load(std::memory_order_relaxed);
+    }
+
+private:
+    struct alignas(64) Fila
+    {
+        std::mutex mutex;
+        std::deque<std::function<void()>> tarefas;
+    };
+
+    // Pool e fila da trabalhadora que roda na thread atual (nulo fora de qualquer pool)
+    static inline thread_local const PoolDeTrabalho *pool_atual = nullptr;
+    static inline thread_local unsigned indice_atual = 0;
+
+    bool pegar(unsigned indice, std::function<void()> &tarefa){
+        {
+            Fila &propria = *filas[indice];
+            std::lock_guard<std::mutex> lock(propria.mutex);
+            if (!propria.tarefas.empty()){
+                tarefa = std::move(propria.tarefas.back());
+                propria.tarefas.pop_back();
+                return true;
+            }
+        }
+        for (std::size_t k = 1; k < filas.size(); ++k){
+            Fila &outra = *filas[(indice + k) % filas.size()];
+            std::lock_guard<std::mutex> lock(outra.mutex);
+            if (!outra.tarefas.empty()){
+                tarefa = std::move(outra.tarefas.front());
+                outra.tarefas.pop_front();
+                roubos.fetch_add(1, std::memory_order_relaxed);
+                return true;
+            }
+        }
+        return false;
+    }
+
+    void executa(unsigned indice){
+        pool_atual = this;
+        indice_atual = indice;
+
+        for (;;){
+            std::function<void()> tarefa;
+            if (pegar(indice, tarefa)){
+                enfileiradas.fetch_sub(1, std::memory_order_seq_cst);
+                tarefa();
+
+                if (pendentes.fetch_sub(1, std::memory_order_acq_rel) == 1){
+                    std::lock_guard<std::mutex> lock(ocioso_mutex);
+                    ocioso_cv.notify_all();
+                }
+                continue;
+            }
+
+            std::unique_lock<std::mutex> lock(dormir_mutex);
+            dormindo.fetch_add(1, std::memory_order_seq_cst);
+            dormir_cv.wait(lock, [this] {
+                return encerrando.load(std::memory_order_seq_cst) ||
+                       enfileiradas.load(std::memory_order_seq_cst) > 0;
+            });
+            dormindo.fetch_sub(1, std::memory_order_seq_cst);
+            if (encerrando.load() && enfileiradas.load() == 0) return; // encerrando e sem trabalho restante
+        }
+    }
+
+    std::vector<std::unique_ptr<Fila>> filas;
+    std::vector<std::thread> trabalhadores;
+    alignas(64) std::atomic<std::size_t> pendentes{0};   // submetidas e ainda não terminadas
+    alignas(64) std::atomic<std::size_t> enfileiradas{0}; // esperando em alguma fila
+    alignas(64) std::atomic<std::size_t> proxima_fila{0};
+    std::atomic<unsigned> dormindo{0};
+    std::atomic<std::uint64_t> roubos{0};
+    std::atomic<bool> encerrando{false};
+    std::mutex dormir_mutex;
+    std::condition_variable dormir_cv;
+    std::mutex ocioso_mutex;
+    std::condition_variable ocioso_cv;
+};
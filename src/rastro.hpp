@@ -0,0 +1,196 @@
+#pragma once
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <cstdint>
+#include <cstring>
+#include <string>
+
+#include "configuracao.hpp"
+
+/*
+ * Rastro binário dos eventos das partidas (`--rastro ARQUIVO`), para saber depois quem sentou
+ * em qual cadeira em cada rodada sem depender do texto intercalado das mensagens.
+ *
+ * O arquivo é um cabeçalho seguido de registros de tamanho fixo (`EventoRastro`, 24 bytes).
+ * Ele é pré-alocado com o número exato de eventos que as partidas podem gerar (um por jogador
+ * ativo em cada rodada, mais um por rodada e dois por partida) e mapeado em memória: registrar
+ * um evento é reservar uma posição com `fetch_add` e escrever 24 bytes, sem syscalls e sem
+ * formatação, de qualquer thread. Ao fechar, o cabeçalho recebe o total e o arquivo é cortado
+ * no último evento escrito.
+ *
+ * Os eventos de uma rodada ficam entre o seu `Rodada` e o `Rodada` seguinte, porque o coordenador
+ * só começa a próxima rodada depois de todas as tentativas; dentro da rodada a ordem é a de
+ * reserva das posições. `ferramentas/reproduzir_rastro.cpp` lê e valida o arquivo.
+ */
+enum class TipoEvento : std::uint8_t
+{
+    Partida,   // jogador = número de jogadores, cadeira = número da partida no rastro
+    Rodada,    // a música parou: jogador = ativos na rodada, cadeira = cadeiras da rodada
+    Sentou,    // jogador sentou na cadeira (a partir de 1)
+    Eliminado, // jogador não conseguiu cadeira
+    Vencedor   // fim da partida: jogador = vencedor (0 se interrompida), rodada = rodadas jogadas
+};
+
+struct EventoRastro
+{
+    std::uint32_t rodada;
+    std::uint32_t jogador;
+    std::uint32_t cadeira;
+    TipoEvento tipo;
+    std::uint8_t reservado[3];
+    std::uint64_t instante_ns; // agora_ns() (relógio monotônico)
+};
+static_assert(sizeof(EventoRastro) == 24, "registro de tamanho fixo");
+
+struct CabecalhoRastro
+{
+    char magica[8];               // "JDCRASTR"
+    std::uint32_t versao;
+    std::uint32_t tamanho_evento; // sizeof(EventoRastro)
+    std::uint64_t num_eventos;    // escrito ao fechar
+    std::uint64_t num_partidas;
+};
+static_assert(sizeof(CabecalhoRastro) == 32, "cabeçalho de tamanho fixo");
+
+inline constexpr char MAGICA_RASTRO[8] = {'J', 'D', 'C', 'R', 'A', 'S', 'T', 'R'};
+inline constexpr std::uint32_t VERSAO_RASTRO = 1;
+
+class Rastro
+{
+public:
+    Rastro() = default;
+    Rastro(const Rastro&) = delete;
+    Rastro& operator=(const Rastro&) = delete;
+
+    ~Rastro(){
+        fechar();
+    }
+
+    // Cria o arquivo com espaço para `capacidade` eventos; em caso de erro retorna false e
+    // `erro()` descreve o motivo
+    bool abrir(const std::string &caminho, std::uint64_t capacidade){
+        fechar();
+        descritor = ::open(caminho.c_str(), O_RDWR | O_CREAT | O_TRUNC, 0644);
+        if (descritor < 0) return falhar("open");
+
+        tamanho = sizeof(CabecalhoRastro) + capacidade * sizeof(EventoRastro);
+        // Reserva os blocos no disco agora: com o arquivo só esparso, faltar espaço no meio da
+        // partida viraria um SIGBUS na escrita do mapa
+        const int reserva = posix_fallocate(descritor, 0, static_cast<off_t>(tamanho));
+        if (reserva != 0 && (reserva != EOPNOTSUPP || ::ftruncate(descritor, static_cast<off_t>(tamanho)) != 0)){
+            errno = reserva;
+            return falhar("posix_fallocate");
+        }
+
+        void *mapa = ::mmap(nullptr, tamanho, PROT_READ | PROT_WRITE, MAP_SHARED, descritor, 0);
+        if (mapa == MAP_FAILED) return falhar("mmap");
+        cabecalho = static_cast<CabecalhoRastro*>(mapa);
+        eventos = reinterpret_cast<EventoRastro*>(cabecalho + 1);
+        this->capacidade = capacidade;
+        proximo.store(0, std::memory_order_relaxed);
+        partidas = 0;
+
+        std::memcpy(cabecalho->magica, MAGICA_RASTRO, sizeof(MAGICA_RASTRO));
+        cabecalho->versao = VERSAO_RASTRO;
+        cabecalho->tamanho_evento = sizeof(EventoRastro);
+        cabecalho->num_eventos = 0;
+        cabecalho->num_partidas = 0;
+        return true;
+    }
+
+    // Eventos de uma partida com esta configuração: o Partida, um Rodada e uma tentativa por
+    // ativo em cada rodada e o Vencedor
+    static std::uint64_t eventos_para(const Configuracao &config){
+        std::uint64_t total = 2;
+        int ativos = config.num_jogadores;
+        for (int rodadas = 0; ativos > 1 && (config.max_rodadas == 0 || rodadas < config.max_rodadas); ++rodadas){
+            total += 1 + static_cast<std::uint64_t>(ativos);
+            ativos = config.remocao.cadeiras_para(ativos);
+        }
+        return total;
+    }
+
+    bool aberto() const{
+        return cabecalho != nullptr;
+    }
+
+    // Seguro para várias threads ao mesmo tempo. Além da capacidade, o evento é contado e descartado
+    void registrar(TipoEvento tipo, std::uint32_t rodada, std::uint32_t jogador, std::uint32_t cadeira,
+                   std::uint64_t instante_ns){
+        const std::uint64_t posicao = proximo.fetch_add(1, std::memory_order_relaxed);
+        if (posicao >= capacidade){
+            descartados.fetch_add(1, std::memory_order_relaxed);
+            return;
+        }
+        eventos[posicao] = EventoRastro{rodada, jogador, cadeira, tipo, {0, 0, 0}, instante_ns};
+    }
+
+    // Número da próxima partida (usado no evento Partida)
+    std::uint32_t iniciar_partida(){
+        return static_cast<std::uint32_t>(partidas++);
+    }
+
+    std::uint64_t get_descartados() const{
+        return descartados.load(std::memory_order_relaxed);
+    }
+
+    const std::string& erro() const{
+        return mensagem_erro;
+    }
+
+    // Grava o total no cabeçalho, corta o arquivo no último evento e desfaz o mapa; em caso de
+    // erro retorna false e `erro()` descreve o motivo (o arquivo pode ter ficado incompleto)
+    bool fechar(){
+        bool ok = true;
+        if (cabecalho){
+            const std::uint64_t escritos = std::min(proximo.load(std::memory_order_acquire), capacidade);
+            cabecalho->num_eventos = escritos;
+            cabecalho->num_partidas = partidas;
+            if (::munmap(cabecalho, tamanho) != 0){
+                mensagem_erro = std::string("munmap: ") + std::strerror(errno);
+                ok = false;
+            }
+            if (::ftruncate(descritor, static_cast<off_t>(sizeof(CabecalhoRastro) + escritos * sizeof(EventoRastro))) != 0){
+                mensagem_erro = std::string("ftruncate: ") + std::strerror(errno);
+                ok = false;
+            }
+            cabecalho = nullptr;
+            eventos = nullptr;
+        }
+        if (descritor >= 0){
+            if (::close(descritor) != 0 && ok){
+                mensagem_erro = std::string("close: ") + std::strerror(errno);
+                ok = false;
+            }
+            descritor = -1;
+        }
+        return ok;
+    }
+
+private:
+    bool falhar(const char *operacao){
+        mensagem_erro = std::string(operacao) + ": " + std::strerror(errno);
+        if (descritor >= 0){
+            ::close(descritor);
+            descritor = -1;
+        }
+        return false;
+    }
+
+    int descritor = -1;
+    std::size_t tamanho = 0;
+    CabecalhoRastro *cabecalho = nullptr;
+    EventoRastro *eventos = nullptr;
+    std::uint64_t capacidade = 0;
+    std::uint64_t partidas = 0;
+    std::string mensagem_erro;
+    alignas(64) std::atomic<std::uint64_t> proximo{0};
+    std::atomic<std::uint64_t> descartados{0};
+};
@@ -0,0 +1,234 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdarg>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "relogio.hpp"
+
+/*
+ * Registro assíncrono das mensagens do jogo.
+ *
+ * Cada thread escreve em um anel SPSC próprio (ela é a única produtora, a thread escritora é a
+ * única consumidora), então registrar uma mensagem é só formatá-la no slot livre e publicar o
+ * índice, sem mutex e sem E/S. A thread escritora drena todos os anéis em lotes, ordena o lote
+ * pelo instante de cada mensagem e faz um único `fwrite` por lote.
+ *
+ * Compilando com `JOGO_SILENCIOSO` (opção CMake de mesmo nome), `REGISTRAR` não gera código
+ * algum; `--silencioso` desliga o registro em tempo de execução.
+ */
+class Registro
+{
+public:
+    static Registro& instancia(){
+        static Registro registro;
+        return registro;
+    }
+
+    Registro(const Registro&) = delete;
+    Registro& operator=(const Registro&) = delete;
+
+    ~Registro(){
+        encerrando.store(true, std::memory_order_release);
+        if (escritor.joinable()){
+            escritor.join();
+        }
+    }
+
+    bool esta_ativo() const{
+        return ativo.load(std::memory_order_relaxed);
+    }
+
+    void set_ativo(bool valor){
+        ativo.store(valor, std::memory_order_relaxed);
+    }
+
+    void registrar(const char *formato, ...) __attribute__((format(printf, 2, 3))){
+        Anel &anel = anel_da_thread();
+        const std::uint64_t cabeca = anel.cabeca.load(std::memory_order_relaxed);
+
+        // Anel cheio: espera a escritora liberar espaço em vez de perder a mensagem
+        while (cabeca - anel.cauda.load(std::memory_order_acquire) >= TAMANHO_ANEL){
+            std::this_thread::yield();
+        }
+
+        Mensagem &msg = anel.mensagens[cabeca % TAMANHO_ANEL];
+        va_list args;
+        va_start(args, formato);
+        int n = std::vsnprintf(msg.texto, sizeof(msg.texto), formato, args);
+        va_end(args);
+        msg.tamanho = static_cast<std::uint16_t>(std::clamp<int>(n, 0, sizeof(msg.texto) - 1));
+        msg.instante = agora_ns();
+
+        anel.cabeca.store(cabeca + 1, std::memory_order_release);
+    }
+
+    // Bloqueia até que tudo o que já foi registrado (por qualquer thread) tenha sido escrito
+    void descarregar(){
+        std::vector<std::pair<Anel*, std::uint64_t>> alvos;
+        {
+            std::lock_guard<std::mutex> lock(aneis_mutex);
+            for (auto &anel : aneis){
+                alvos.emplace_back(anel.get(), anel->cabeca.load(std::memory_order_acquire));
+            }
+        }
+        for (auto &[anel, alvo] : alvos){
+            while (anel->cauda.load(std::memory_order_acquire) < alvo){
+                forcar_escrita.store(true, std::memory_order_release);
+                std::this_thread::yield();
+            }
+        }
+    }
+
+    // Mensagens publicadas e ainda não escritas, somando todos os anéis
+    std::uint64_t profundidade() const{
+        std::lock_guard<std::mutex> lock(aneis_mutex);
+        std::uint64_t total = 0;
+        for (auto &anel : aneis){
+            total += anel->cabeca.load(std::memory_order_acquire) - anel->cauda.load(std::memory_order_acquire);
+        }
+        return total;
+    }
+
+private:
+    static constexpr std::uint64_t TAMANHO_ANEL = 32;
+    // Mensagens mais novas que isso esperam o próximo lote, para dar tempo de outras threads
+    // publicarem mensagens com instante anterior e a saída sair na ordem em que aconteceu
+    static constexpr std::uint64_t ATRASO_ORDENACAO_NS = 500'000;
+
+    struct Mensagem
+    {
+        std::uint64_t instante;
+        std::uint16_t tamanho;
+        char texto[246];
+    };
+
+    struct Anel
+    {
+        alignas(64) std::atomic<std::uint64_t> cabeca{0}; // escrita pela produtora
+        alignas(64) std::atomic<std::uint64_t> cauda{0};  // escrita pela escritora
+        std::atomic<bool> abandonado{false};
+        bool livre = false; // protegido por aneis_mutex
+        Mensagem mensagens[TAMANHO_ANEL];
+    };
+
+    // Devolve o anel para reuso quando a thread termina
+    struct Vinculo
+    {
+        Anel *anel = nullptr;
+        ~Vinculo(){
+            if (anel) anel->abandonado.store(true, std::memory_order_release);
+        }
+    };
+
+    struct Pendente
+    {
+        std::uint64_t instante;
+        Anel *anel;
+        std::uint64_t indice;
+    };
+
+    Registro()
+        : escritor(&Registro::escreve, this) {}
+
+    Anel& anel_da_thread(){
+        static thread_local Vinculo vinculo;
+        if (!vinculo.anel){
+            std::lock_guard<std::mutex> lock(aneis_mutex);
+            for (auto &anel : aneis){
+                if (anel->livre){
+                    anel->livre = false;
+                    anel->abandonado.store(false, std::memory_order_relaxed);
+                    vinculo.anel = anel.get();
+                    break;
+                }
+            }
+            if (!vinculo.anel){
+                aneis.push_back(std::make_unique<Anel>());
+                vinculo.anel = aneis.back().get();
+            }
+        }
+        return *vinculo.anel;
+    }
+
+    void escreve(){
+        std::vector<Pendente> lote;
+        std::string saida;
+        auto espera = std::chrono::microseconds(50);
+
+        for (;;){
+            const bool ultimo = encerrando.load(std::memory_order_acquire);
+            const bool forcar = ultimo || forcar_escrita.exchange(false, std::memory_order_acq_rel);
+            const std::uint64_t limite = forcar ? UINT64_MAX : agora_ns() - ATRASO_ORDENACAO_NS;
+
+            lote.clear();
+            {
+                std::lock_guard<std::mutex> lock(aneis_mutex);
+                for (auto &anel : aneis){
+                    const std::uint64_t cabeca = anel->cabeca.load(std::memory_order_acquire);
+                    std::uint64_t i = anel->cauda.load(std::memory_order_relaxed);
+                    for (; i < cabeca; ++i){
+                        const Mensagem &msg = anel->mensagens[i % TAMANHO_ANEL];
+                        if (msg.instante > limite) break;
+                        lote.push_back({msg.instante, anel.get(), i});
+                    }
+                    // Um anel sem dona pode ser reaproveitado mesmo com mensagens pendentes: a
+                    // próxima thread continua a partir da cabeça atual
+                    if (!anel->livre && anel->abandonado.load(std::memory_order_acquire)){
+                        anel->livre = true;
+                    }
+                }
+            }
+
+            if (!lote.empty()){
+                espera = std::chrono::microseconds(50);
+                std::stable_sort(lote.begin(), lote.end(),
+                                 [](const Pendente &a, const Pendente &b) { return a.instante < b.instante; });
+                saida.clear();
+                for (const auto &p : lote){
+                    const Mensagem &msg = p.anel->mensagens[p.indice % TAMANHO_ANEL];
+                    saida.append(msg.texto, msg.tamanho);
+                }
+                std::fwrite(saida.data(), 1, saida.size(), stdout);
+                std::fflush(stdout);
+
+                // Só devolve os slots depois de copiar o texto; as mensagens de um anel estão em
+                // ordem no lote, então a última vista de cada anel define a nova cauda
+                for (const auto &p : lote){
+                    p.anel->cauda.store(p.indice + 1, std::memory_order_release);
+                }
+            } else if (ultimo){
+                return;
+            } else {
+                // Sem mensagens: espera cada vez mais, até 2ms, para não girar à toa entre rodadas
+                std::this_thread::sleep_for(espera);
+                espera = std::min(espera * 2, std::chrono::microseconds(2000));
+            }
+        }
+    }
+
+    std::atomic<bool> ativo{true};
+    std::atomic<bool> encerrando{false};
+    std::atomic<bool> forcar_escrita{false};
+    mutable std::mutex aneis_mutex;
+    std::vector<std::unique_ptr<Anel>> aneis;
+    std::thread escritor;
+};
+
+#ifdef JOGO_SILENCIOSO
+#define REGISTRAR(...) ((void)0)
+#else
+#define REGISTRAR(...) \
+    do { \
+        if (Registro::instancia().esta_ativo()) Registro::instancia().registrar(__VA_ARGS__); \
+    } while (0)
+#endif
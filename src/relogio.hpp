@@ -0,0 +1,20 @@
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+
+// Relógio monotônico em ns, usado em todas as medições (latências, rastro, registro, métricas)
+inline std::uint64_t agora_ns(){
+    return static_cast<std::uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count());
+}
+
+// Uma volta de espera ativa: avisa a CPU que a thread está girando (libera o núcleo irmão e evita
+// o custo de sair do laço), sem ceder a CPU ao sistema operacional
+inline void pausar(){
+#if defined(__x86_64__) || defined(__i386__)
+    __builtin_ia32_pause();
+#elif defined(__aarch64__)
+    asm volatile("yield");
+#endif
+}
@@ -0,0 +1,38 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// Resultados devolvidos pelo motor (Motor, executar_partida, Torneio); sem dependência do resto do jogo
+
+// Latências de uma rodada, medidas a partir do instante em que a música parou
+struct EstatisticaRodada
+{
+    int jogadores;
+    int cadeiras;
+    std::uint64_t ate_todos_sentados_ns; // até a última tentativa de sentar (0 se não medido)
+    std::uint64_t ate_eliminacao_ns;     // até o coordenador conhecer os eliminados
+};
+
+struct ResultadoPartida
+{
+    int vencedor;  // -1 se a partida foi interrompida por max_rodadas
+    int rodadas;
+    std::uint64_t tempo_virtual_ms;
+    std::vector<EstatisticaRodada> estatisticas;
+    std::uint64_t esperas_girando;      // --sinal adaptativo: esperas dos jogadores que não estacionaram
+    std::uint64_t esperas_estacionadas; // e as que estacionaram no futex
+    std::uint64_t ate_primeira_rodada_ns; // do pedido da partida até a música da primeira rodada começar
+};
+
+struct ResultadoTorneio
+{
+    int campeao;
+    int niveis;
+    std::size_t mesas;
+    std::uint64_t rodadas;
+    double segundos;
+    unsigned threads;     // trabalhadoras do pool
+    std::uint64_t roubos; // tarefas roubadas entre trabalhadoras durante o torneio
+};
@@ -0,0 +1,55 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <memory_resource>
+#include <vector>
+
+/*
+ * Sinal de "a música parou" baseado em contador de geração.
+ *
+ * Cada parada da música incrementa a geração. Um jogador guarda a última geração que viu e
+ * espera com `std::atomic::wait` até ela mudar, sem precisar readquirir um mutex global ao
+ * acordar (como acontece com `music_cv`/`music_mutex`). Os jogadores são distribuídos entre
+ * vários fragmentos, cada um em sua própria linha de cache, para que as esperas não disputem
+ * a mesma palavra.
+ */
+class SinalMusica
+{
+public:
+    explicit SinalMusica(unsigned num_fragmentos = 16,
+                         std::pmr::memory_resource *recurso = std::pmr::get_default_resource())
+        : num_fragmentos(num_fragmentos == 0 ? 1 : num_fragmentos),
+          fragmentos(this->num_fragmentos, recurso) {}
+
+    // Incrementa a geração de todos os fragmentos e acorda quem espera neles
+    void sinalizar(){
+        std::uint32_t nova = geracao_atual.fetch_add(1, std::memory_order_acq_rel) + 1;
+        for (unsigned i = 0; i < num_fragmentos; ++i){
+            fragmentos[i].geracao.store(nova, std::memory_order_release);
+            fragmentos[i].geracao.notify_all();
+        }
+    }
+
+    // Bloqueia enquanto a geração do fragmento for igual a `vista`; retorna a nova geração
+    std::uint32_t esperar(unsigned fragmento, std::uint32_t vista) const{
+        const auto &g = fragmentos[fragmento % num_fragmentos].geracao;
+        g.wait(vista, std::memory_order_acquire);
+        return g.load(std::memory_order_acquire);
+    }
+
+    // Geração atual do fragmento, sem bloquear (para quem gira antes de esperar)
+    std::uint32_t geracao(unsigned fragmento) const{
+        return fragmentos[fragmento % num_fragmentos].geracao.load(std::memory_order_acquire);
+    }
+
+private:
+    struct alignas(64) Fragmento
+    {
+        std::atomic<std::uint32_t> geracao{0};
+    };
+
+    unsigned num_fragmentos;
+    std::pmr::vector<Fragmento> fragmentos;
+    std::atomic<std::uint32_t> geracao_atual{0};
+};
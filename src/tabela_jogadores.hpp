@@ -0,0 +1,92 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <memory_resource>
+#include <vector>
+
+#include "operacoes_bits.hpp"
+
+/*
+ * Estado dos jogadores em estrutura de arrays: um bit por jogador para "ativo" e outro para
+ * "tentou nesta rodada", empacotados em palavras de 64 bits acessadas com `std::atomic_ref`.
+ *
+ * Um milhão de jogadores ocupam 2 x 125KB em vez de um objeto com dois atômicos cada, e as
+ * operações em massa trabalham uma palavra (64 jogadores) por vez: reiniciar a rodada é zerar
+ * as palavras de tentativa e os eliminados da rodada são `tentou & ~ativo`, palavra a palavra.
+ * Essas varreduras usam as versões vetoriais de `OperacoesBits` (4 ou 8 palavras por instrução):
+ * zerar as tentativas de um milhão de jogadores leva poucos microssegundos.
+ */
+class TabelaJogadores
+{
+public:
+    explicit TabelaJogadores(std::size_t num_jogadores,
+                             std::pmr::memory_resource *recurso = std::pmr::get_default_resource())
+        : num_jogadores(num_jogadores),
+          ativos((num_jogadores + 63) / 64, ~std::uint64_t{0}, recurso),
+          tentativas((num_jogadores + 63) / 64, 0, recurso){
+        // Bits além do último jogador ficam zerados para não entrarem na contagem
+        if (num_jogadores % 64 != 0){
+            ativos.back() = (std::uint64_t{1} << (num_jogadores % 64)) - 1;
+        }
+    }
+
+    bool esta_ativo(std::size_t indice) const{
+        return (palavra(ativos, indice).load(std::memory_order_acquire) >> (indice % 64)) & 1;
+    }
+
+    void eliminar(std::size_t indice){
+        palavra(ativos, indice).fetch_and(~bit(indice), std::memory_order_acq_rel);
+    }
+
+    // Marca a tentativa da rodada; retorna true só para a primeira marcação
+    bool marcar_tentativa(std::size_t indice){
+        return (palavra(tentativas, indice).fetch_or(bit(indice), std::memory_order_acq_rel) & bit(indice)) == 0;
+    }
+
+    bool tentou(std::size_t indice) const{
+        return (palavra(tentativas, indice).load(std::memory_order_acquire) >> (indice % 64)) & 1;
+    }
+
+    void limpar_tentativa(std::size_t indice){
+        palavra(tentativas, indice).fetch_and(~bit(indice), std::memory_order_acq_rel);
+    }
+
+    // As varreduras abaixo usam stores e loads simples (vetoriais), por isso só o coordenador as
+    // chama, entre `aguardar_tentativas` (ou o fim do despacho) e a próxima `parar_musica`: todos
+    // os jogadores da rodada já tentaram, o que o coordenador viu com acquire, e esperam a música
+    // sem tocar nas palavras; a próxima parada (store release) publica o que foi escrito aqui
+
+    // Zera as tentativas de todos os jogadores
+    void limpar_tentativas(){
+        OperacoesBits::atual().zerar(tentativas.data(), tentativas.size());
+    }
+
+    // Máscara (`num_palavras()` palavras) de quem tentou nesta rodada e não está mais ativo: os
+    // eliminados da rodada. Retorna quantos
+    std::size_t eliminados_da_rodada(std::uint64_t *saida) const{
+        return OperacoesBits::atual().diferenca(saida, tentativas.data(), ativos.data(), ativos.size());
+    }
+
+    std::size_t num_palavras() const{
+        return ativos.size();
+    }
+
+    std::size_t tamanho() const{
+        return num_jogadores;
+    }
+
+private:
+    static std::uint64_t bit(std::size_t indice){
+        return std::uint64_t{1} << (indice % 64);
+    }
+
+    static std::atomic_ref<std::uint64_t> palavra(std::pmr::vector<std::uint64_t> &palavras, std::size_t indice){
+        return std::atomic_ref<std::uint64_t>(palavras[indice / 64]);
+    }
+
+    std::size_t num_jogadores;
+    // mutable: leituras via atomic_ref exigem referência não-const
+    mutable std::pmr::vector<std::uint64_t> ativos;
+    mutable std::pmr::vector<std::uint64_t> tentativas;
+};
@@ -0,0 +1,162 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "topologia.hpp"
+
+/*
+ * Threads estacionadas entre partidas.
+ *
+ * No modo threads cada partida criava e juntava uma thread por jogador, além da do coordenador;
+ * em partidas curtas em sequência isso é a maior parte do tempo. Aqui as threads são criadas uma
+ * vez e, entre partidas, ficam paradas em `std::atomic::wait` sobre uma geração. `executar(n, f)`
+ * publica a tarefa, avança a geração e acorda as threads: a thread i executa `f(i)` para i < n e
+ * volta a estacionar assim que `f` retorna (o jogador eliminado estaciona na hora, como antes
+ * terminava). `executar` só retorna depois que as n tarefas terminaram e as demais threads
+ * confirmaram a geração.
+ *
+ * Faltando threads, as que faltam são criadas na hora e ficam para as próximas partidas. Com
+ * `fixar_cpus`, a thread i fica presa à CPU `Topologia::cpu_para(i)`; se a opção mudar entre
+ * partidas, as threads são recriadas. `reservar(n)` cria as threads antes da partida (início
+ * rápido) e, com muitas faltando, divide a criação entre algumas threads criadoras, uma por CPU:
+ * criar uma thread é uma syscall com mapeamento da pilha, e milhares delas em série atrasam
+ * a primeira rodada.
+ */
+class ThreadsEstacionadas
+{
+public:
+    ThreadsEstacionadas() = default;
+    ThreadsEstacionadas(const ThreadsEstacionadas&) = delete;
+    ThreadsEstacionadas& operator=(const ThreadsEstacionadas&) = delete;
+
+    ~ThreadsEstacionadas(){
+        encerrar();
+    }
+
+    // Executa `tarefa(i)` para i em [0, n), cada um em uma thread, e espera todas terminarem.
+    // `tarefa` é usada por referência: sem cópia e sem alocação
+    template <typename Tarefa>
+    void executar(std::size_t n, bool fixar_cpus, Tarefa &tarefa){
+        if (n == 0) return;
+        if (fixar_cpus != fixadas) encerrar();
+        fixadas = fixar_cpus;
+        crescer(n);
+
+        funcao = [](void *contexto, std::size_t i) { (*static_cast<Tarefa*>(contexto))(i); };
+        contexto = &tarefa;
+        ativas = n;
+        // Todas as threads respondem, mesmo as sem tarefa: nenhuma fica para trás lendo
+        // `funcao` ou `ativas` quando a próxima partida os reescrever
+        restantes.store(static_cast<std::uint32_t>(threads.size()), std::memory_order_relaxed);
+        geracao.fetch_add(1, std::memory_order_release); // publica funcao, contexto e ativas
+        geracao.notify_all();
+
+        // Variável de condição, não std::atomic::wait: a espera de atomic::wait começa girando, e
+        // com poucos núcleos essa thread tomaria a CPU do coordenador no início da partida
+        std::unique_lock<std::mutex> lock(fim_mutex);
+        fim_cv.wait(lock, [this] { return restantes.load(std::memory_order_acquire) == 0; });
+    }
+
+    // Cria de antemão as threads para `n` tarefas, em paralelo quando faltam muitas
+    void reservar(std::size_t n, bool fixar_cpus){
+        if (fixar_cpus != fixadas) encerrar();
+        fixadas = fixar_cpus;
+        crescer(n, Topologia::sistema().num_cpus());
+    }
+
+    std::size_t tamanho() const{
+        return threads.size();
+    }
+
+    // Quantas threads foram criadas desde a criação do objeto (inclusive recriações)
+    std::size_t get_criadas() const{
+        return criadas;
+    }
+
+private:
+    using Funcao = void (*)(void*, std::size_t);
+
+    // Com poucas threads por criadora, criar as criadoras custaria mais do que dividir o trabalho
+    static constexpr std::size_t MIN_POR_CRIADORA = 256;
+
+    void crescer(std::size_t n, unsigned max_criadoras = 1){
+        if (threads.size() >= n) return;
+        const std::size_t primeira = threads.size();
+        // Nascem já tendo visto a geração atual: só executam a partir da próxima
+        const std::uint32_t vista = geracao.load(std::memory_order_relaxed);
+        threads.resize(n); // cada criadora preenche a sua faixa, sem realocar o vetor
+        auto criar = [this, vista](std::size_t de, std::size_t ate) {
+            for (std::size_t indice = de; indice < ate; ++indice){
+                threads[indice] = std::thread(&ThreadsEstacionadas::estacionar, this, indice, vista);
+                if (fixadas){
+                    Topologia::fixar(threads[indice].native_handle(), Topologia::sistema().cpu_para(indice));
+                }
+            }
+        };
+
+        const std::size_t faltam = n - primeira;
+        const std::size_t criadoras = std::clamp<std::size_t>(faltam / MIN_POR_CRIADORA, 1, std::max(1u, max_criadoras));
+        std::vector<std::thread> ajudantes;
+        ajudantes.reserve(criadoras - 1);
+        for (std::size_t c = 1; c < criadoras; ++c){
+            ajudantes.emplace_back(criar, primeira + faltam * c / criadoras, primeira + faltam * (c + 1) / criadoras);
+        }
+        criar(primeira, primeira + faltam / criadoras); // a primeira faixa fica com quem chamou
+        for (auto &t : ajudantes){
+            t.join();
+        }
+        criadas += faltam;
+    }
+
+    void estacionar(std::size_t indice, std::uint32_t vista){
+        for (;;){
+            geracao.wait(vista, std::memory_order_acquire);
+            vista = geracao.load(std::memory_order_acquire);
+            if (encerrando.load(std::memory_order_acquire)) return;
+
+            if (indice < ativas){
+                funcao(contexto, indice);
+            }
+            if (restantes.fetch_sub(1, std::memory_order_acq_rel) == 1){
+                std::lock_guard<std::mutex> lock(fim_mutex);
+                fim_cv.notify_one();
+            }
+        }
+    }
+
+    void encerrar(){
+        if (threads.empty()) return;
+        encerrando.store(true, std::memory_order_release);
+        geracao.fetch_add(1, std::memory_order_release);
+        geracao.notify_all();
+        for (auto &t : threads){
+            if (t.joinable()){
+                t.join();
+            }
+        }
+        threads.clear();
+        encerrando.store(false, std::memory_order_relaxed);
+    }
+
+    std::vector<std::thread> threads;
+    bool fixadas = false;
+    std::size_t criadas = 0;
+
+    // Escritos só com todas as threads estacionadas, antes de avançar a geração
+    Funcao funcao = nullptr;
+    void *contexto = nullptr;
+    std::size_t ativas = 0;
+
+    alignas(64) std::atomic<std::uint32_t> geracao{0};
+    std::atomic<bool> encerrando{false};
+    alignas(64) std::atomic<std::uint32_t> restantes{0};
+    std::mutex fim_mutex;
+    std::condition_variable fim_cv;
+};
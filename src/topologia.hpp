@@ -0,0 +1,130 @@
+#pragma once
+
+#include <pthread.h>
+#include <sched.h>
+
+#include <algorithm>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+/*
+ * Topologia de CPUs e nós NUMA da máquina, lida uma vez de /sys/devices/system/node.
+ *
+ * Serve para duas coisas: fixar threads em núcleos (`--fixar`), distribuindo-as nó a nó, e
+ * descobrir em que nó a thread atual está rodando, para que o jogador dispute primeiro as
+ * cadeiras do próprio nó (`CadeirasPorNo`). Só entram as CPUs que o processo pode usar; sem
+ * /sys (ou fora do Linux) tudo vira um único nó.
+ */
+class Topologia
+{
+public:
+    static const Topologia& sistema(){
+        static const Topologia topologia;
+        return topologia;
+    }
+
+    unsigned num_nos() const{
+        return static_cast<unsigned>(cpus_por_no.size());
+    }
+
+    // Número de CPUs utilizáveis; ao contrário de hardware_concurrency(), não relê /sys a cada chamada
+    unsigned num_cpus() const{
+        return static_cast<unsigned>(ordem.size());
+    }
+
+    // CPUs utilizáveis agrupadas por nó: todas as do nó 0, depois as do nó 1, ...
+    const std::vector<unsigned>& cpus_em_ordem() const{
+        return ordem;
+    }
+
+    unsigned no_da_cpu(unsigned cpu) const{
+        return cpu < no_por_cpu.size() ? no_por_cpu[cpu] : 0;
+    }
+
+    // Nó em que a thread atual está rodando agora (sched_getcpu é barato: vDSO/rseq)
+    unsigned no_atual() const{
+        if (cpus_por_no.size() == 1) return 0;
+        const int cpu = sched_getcpu();
+        return cpu < 0 ? 0 : no_da_cpu(static_cast<unsigned>(cpu));
+    }
+
+    // Fixa a thread em uma CPU; retorna false se o sistema recusar
+    static bool fixar(pthread_t thread, unsigned cpu){
+        cpu_set_t conjunto;
+        CPU_ZERO(&conjunto);
+        CPU_SET(cpu, &conjunto);
+        return pthread_setaffinity_np(thread, sizeof(conjunto), &conjunto) == 0;
+    }
+
+    // CPU para a i-ésima thread: percorre `cpus_em_ordem()` em rodízio
+    unsigned cpu_para(std::size_t i) const{
+        return ordem[i % ordem.size()];
+    }
+
+private:
+    Topologia(){
+        cpu_set_t permitidas;
+        CPU_ZERO(&permitidas);
+        const bool tem_mascara = sched_getaffinity(0, sizeof(permitidas), &permitidas) == 0;
+        auto permitida = [&](unsigned cpu) {
+            return !tem_mascara || (cpu < CPU_SETSIZE && CPU_ISSET(cpu, &permitidas));
+        };
+
+        // Os números dos nós podem ter buracos: a lista vem de "online"
+        for (unsigned no : ler_lista(ler_linha("/sys/devices/system/node/online"))){
+            std::vector<unsigned> cpus;
+            for (unsigned cpu : ler_lista(ler_linha("/sys/devices/system/node/node" + std::to_string(no) + "/cpulist"))){
+                if (permitida(cpu)) cpus.push_back(cpu);
+            }
+            if (!cpus.empty()) cpus_por_no.push_back(std::move(cpus));
+        }
+
+        if (cpus_por_no.empty()){
+            std::vector<unsigned> cpus;
+            const unsigned total = std::max(1u, std::thread::hardware_concurrency());
+            for (unsigned cpu = 0; cpu < total; ++cpu){
+                if (permitida(cpu)) cpus.push_back(cpu);
+            }
+            if (cpus.empty()) cpus.push_back(0);
+            cpus_por_no.push_back(std::move(cpus));
+        }
+
+        for (unsigned no = 0; no < cpus_por_no.size(); ++no){
+            for (unsigned cpu : cpus_por_no[no]){
+                ordem.push_back(cpu);
+                if (cpu >= no_por_cpu.size()) no_por_cpu.resize(cpu + 1, 0);
+                no_por_cpu[cpu] = no;
+            }
+        }
+    }
+
+    static std::string ler_linha(const std::string &caminho){
+        std::ifstream arquivo(caminho);
+        std::string linha;
+        std::getline(arquivo, linha);
+        return linha;
+    }
+
+    // Formato do kernel: "0-3,8-11"
+    static std::vector<unsigned> ler_lista(const std::string &lista){
+        std::vector<unsigned> cpus;
+        std::stringstream ss(lista);
+        std::string item;
+        while (std::getline(ss, item, ',')){
+            if (item.empty()) continue;
+            const std::size_t traco = item.find('-');
+            const unsigned inicio = static_cast<unsigned>(std::stoul(item.substr(0, traco)));
+            const unsigned fim = traco == std::string::npos ? inicio
+                                                            : static_cast<unsigned>(std::stoul(item.substr(traco + 1)));
+            for (unsigned cpu = inicio; cpu <= fim; ++cpu) cpus.push_back(cpu);
+        }
+        return cpus;
+    }
+
+    std::vector<std::vector<unsigned>> cpus_por_no;
+    std::vector<unsigned> ordem;
+    std::vector<unsigned> no_por_cpu;
+};
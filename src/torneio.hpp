@@ -0,0 +1,155 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <random>
+#include <vector>
+
+#include "configuracao.hpp"
+#include "jogo.hpp"
+#include "contexto_partida.hpp"
+#include "pool_trabalho.hpp"
+#include "resultado.hpp"
+
+/*
+ * Torneio em chaves: os jogadores são divididos em mesas de até `jogadores_por_mesa`, cada mesa
+ * é uma partida independente (um JogoDasCadeiras próprio) e o vencedor de cada mesa avança para
+ * uma mesa do nível seguinte, até restar um campeão.
+ *
+ * Cada mesa roda no modo simulado, inteira dentro de uma tarefa do pool com roubo de tarefas.
+ * Não há estado compartilhado entre mesas além dos contadores da chave: a última mesa a
+ * terminar entre as que alimentam outra submete essa mesa, a partir da própria trabalhadora.
+ * A semente de cada mesa deriva da semente do torneio e do índice da mesa, então o campeão
+ * não depende da ordem em que as threads executam as mesas. Cada trabalhadora reaproveita o seu
+ * ContextoPartida de mesa em mesa, então, depois das primeiras mesas, jogar uma mesa não aloca.
+ */
+class Torneio
+{
+public:
+    Torneio(const Configuracao &base, int jogadores_por_mesa, PoolDeTrabalho &pool)
+        : base(base), jogadores_por_mesa(jogadores_por_mesa < 2 ? 2 : jogadores_por_mesa), pool(pool){
+        this->base.simulado = true;
+        this->base.coletar_estatisticas = false;
+        this->base.max_rodadas = 0;
+        if (!this->base.tem_semente){
+            std::random_device rd;
+            this->base.semente = (static_cast<std::uint64_t>(rd()) << 32) | rd();
+            this->base.tem_semente = true;
+        }
+        montar_chave();
+    }
+
+    ResultadoTorneio executar(){
+        const std::uint64_t inicio = agora_ns();
+        const std::uint64_t roubos_antes = pool.get_roubos();
+
+        for (std::size_t i = 0; i < mesas_primeiro_nivel; ++i){
+            submeter_mesa(i);
+        }
+        terminou.wait(false, std::memory_order_acquire);
+
+        return {campeao.load(std::memory_order_acquire), niveis, num_mesas,
+                rodadas_totais.load(std::memory_order_relaxed),
+                (agora_ns() - inicio) / 1e9, pool.tamanho(), pool.get_roubos() - roubos_antes};
+    }
+
+private:
+    static constexpr std::size_t SEM_PROXIMA = static_cast<std::size_t>(-1);
+
+    struct Mesa
+    {
+        std::vector<int> participantes;  // ids globais, preenchidos pelas mesas anteriores
+        std::atomic<int> faltam{0};      // mesas anteriores que ainda não terminaram
+        std::size_t proxima = SEM_PROXIMA;
+        std::size_t posicao_na_proxima = 0;
+    };
+
+    // Monta todos os níveis de uma vez: o nível 0 recebe os jogadores e cada mesa de um nível
+    // acima recebe os vencedores de até `jogadores_por_mesa` mesas consecutivas do nível abaixo
+    void montar_chave(){
+        const std::size_t m = static_cast<std::size_t>(jogadores_por_mesa);
+        std::vector<std::size_t> tamanhos;
+        std::size_t nivel_atual = (static_cast<std::size_t>(base.num_jogadores) + m - 1) / m;
+        tamanhos.push_back(nivel_atual);
+        while (nivel_atual > 1){
+            nivel_atual = (nivel_atual + m - 1) / m;
+            tamanhos.push_back(nivel_atual);
+        }
+
+        num_mesas = 0;
+        for (std::size_t t : tamanhos) num_mesas += t;
+        mesas = std::make_unique<Mesa[]>(num_mesas);
+        niveis = static_cast<int>(tamanhos.size());
+        mesas_primeiro_nivel = tamanhos[0];
+
+        // Nível 0: jogadores 1..N em sequência
+        for (std::size_t i = 0; i < tamanhos[0]; ++i){
+            const std::size_t primeiro = i * m + 1;
+            const std::size_t ultimo = std::min(primeiro + m - 1, static_cast<std::size_t>(base.num_jogadores));
+            for (std::size_t id = primeiro; id <= ultimo; ++id){
+                mesas[i].participantes.push_back(static_cast<int>(id));
+            }
+        }
+
+        // Níveis seguintes: as mesas do nível k alimentam as do nível k+1
+        std::size_t inicio_nivel = 0;
+        for (std::size_t k = 0; k + 1 < tamanhos.size(); ++k){
+            const std::size_t inicio_proximo = inicio_nivel + tamanhos[k];
+            for (std::size_t j = 0; j < tamanhos[k]; ++j){
+                Mesa &mesa = mesas[inicio_nivel + j];
+                Mesa &destino = mesas[inicio_proximo + j / m];
+                mesa.proxima = inicio_proximo + j / m;
+                mesa.posicao_na_proxima = j % m;
+                destino.participantes.resize(j % m + 1);
+                destino.faltam.fetch_add(1, std::memory_order_relaxed);
+            }
+            inicio_nivel = inicio_proximo;
+        }
+    }
+
+    void submeter_mesa(std::size_t indice){
+        pool.submeter([this, indice] { jogar_mesa(indice); });
+    }
+
+    void jogar_mesa(std::size_t indice){
+        Mesa &mesa = mesas[indice];
+        int vencedor = mesa.participantes.empty() ? -1 : mesa.participantes[0];
+
+        // Mesa com um único participante (sobra da divisão): ele avança sem jogar
+        if (mesa.participantes.size() > 1){
+            Configuracao config = base;
+            config.num_jogadores = static_cast<int>(mesa.participantes.size());
+            config.semente = base.semente + 0x9E3779B97F4A7C15ull * (indice + 1);
+
+            static thread_local ContextoPartida contexto;
+            const ResultadoPartida &resultado = contexto.executar(config);
+            vencedor = mesa.participantes[static_cast<std::size_t>(resultado.vencedor - 1)];
+            rodadas_totais.fetch_add(static_cast<std::uint64_t>(resultado.rodadas), std::memory_order_relaxed);
+        }
+
+        if (mesa.proxima == SEM_PROXIMA){
+            campeao.store(vencedor, std::memory_order_release);
+            terminou.store(true, std::memory_order_release);
+            terminou.notify_all();
+            return;
+        }
+
+        Mesa &destino = mesas[mesa.proxima];
+        destino.participantes[mesa.posicao_na_proxima] = vencedor;
+        if (destino.faltam.fetch_sub(1, std::memory_order_acq_rel) == 1){
+            submeter_mesa(mesa.proxima); // última mesa do grupo: a próxima já tem todos os participantes
+        }
+    }
+
+    Configuracao base;
+    int jogadores_por_mesa;
+    PoolDeTrabalho &pool;
+    std::unique_ptr<Mesa[]> mesas;
+    std::size_t num_mesas = 0;
+    std::size_t mesas_primeiro_nivel = 0;
+    int niveis = 0;
+    std::atomic<int> campeao{-1};
+    std::atomic<bool> terminou{false};
+    std::atomic<std::uint64_t> rodadas_totais{0};
+};
@@ -0,0 +1,92 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <memory_resource>
+#include <vector>
+
+#include "disputas.hpp"
+
+/*
+ * Cadeiras com identidade: cada cadeira é um slot atômico que registra qual jogador a ocupou.
+ *
+ * Cada slot fica em sua própria linha de cache (`alignas(64)`), então disputas por cadeiras
+ * vizinhas não causam falso compartilhamento, e não existe um contador global disputado por
+ * todos. O slot guarda `(rodada << 32) | id`: um slot marcado com uma rodada antiga está livre,
+ * então reiniciar a rodada é um único `store` com a nova rodada e capacidade.
+ *
+ * O jogador começa a procurar em uma posição derivada do seu id e percorre as cadeiras
+ * tentando um CAS em cada slot livre. Só é eliminado se encontrar todas ocupadas.
+ */
+class VetorCadeiras
+{
+public:
+    explicit VetorCadeiras(std::uint32_t max_cadeiras,
+                           std::pmr::memory_resource *recurso = std::pmr::get_default_resource())
+        : max_cadeiras(max_cadeiras),
+          slots(max_cadeiras == 0 ? 1 : max_cadeiras, recurso),
+          rodada_atual(compor(1, max_cadeiras)) {}
+
+    // Retorna o índice da cadeira obtida (a partir de 0) ou -1 se todas estão ocupadas
+    std::int64_t ocupar(std::uint32_t jogador_id){
+        const std::uint64_t rodada = rodada_atual.load(std::memory_order_acquire);
+        const std::uint32_t epoca = static_cast<std::uint32_t>(rodada >> 32);
+        const std::uint32_t capacidade = static_cast<std::uint32_t>(rodada);
+        if (capacidade == 0) return -1;
+
+        const std::uint64_t marca = compor(epoca, jogador_id);
+        // Espalha os pontos de partida para que jogadores vizinhos não comecem na mesma cadeira
+        const std::uint32_t inicio = static_cast<std::uint32_t>(
+            (static_cast<std::uint64_t>(jogador_id) * 2654435761u) % capacidade);
+
+        for (std::uint32_t i = 0; i < capacidade; ++i){
+            std::uint32_t indice = inicio + i;
+            if (indice >= capacidade) indice -= capacidade;
+
+            auto &slot = slots[indice].ocupante;
+            std::uint64_t atual = slot.load(std::memory_order_relaxed);
+            if (static_cast<std::uint32_t>(atual >> 32) == epoca) continue; // já ocupada nesta rodada
+
+            if (slot.compare_exchange_strong(atual, marca, std::memory_order_acq_rel,
+                                             std::memory_order_relaxed)){
+                return indice;
+            }
+            // CAS falhou: outro jogador venceu a disputa por esta cadeira
+            Disputas::instancia().registrar();
+        }
+        return -1;
+    }
+
+    void nova_rodada(std::uint32_t cadeiras){
+        if (cadeiras > max_cadeiras) cadeiras = max_cadeiras;
+        std::uint32_t epoca = static_cast<std::uint32_t>(rodada_atual.load(std::memory_order_relaxed) >> 32);
+        rodada_atual.store(compor(epoca + 1, cadeiras), std::memory_order_release);
+    }
+
+    // Id do jogador que ocupou a cadeira nesta rodada, ou 0 se ela está vazia
+    std::uint32_t ocupante(std::uint32_t cadeira) const{
+        const std::uint64_t rodada = rodada_atual.load(std::memory_order_acquire);
+        if (cadeira >= static_cast<std::uint32_t>(rodada)) return 0;
+        std::uint64_t atual = slots[cadeira].ocupante.load(std::memory_order_acquire);
+        if ((atual >> 32) != (rodada >> 32)) return 0;
+        return static_cast<std::uint32_t>(atual);
+    }
+
+    std::uint32_t capacidade() const{
+        return static_cast<std::uint32_t>(rodada_atual.load(std::memory_order_acquire));
+    }
+
+private:
+    struct alignas(64) Slot
+    {
+        std::atomic<std::uint64_t> ocupante{0};
+    };
+
+    static std::uint64_t compor(std::uint32_t alto, std::uint32_t baixo){
+        return (static_cast<std::uint64_t>(alto) << 32) | baixo;
+    }
+
+    std::uint32_t max_cadeiras;
+    std::pmr::vector<Slot> slots;
+    alignas(64) std::atomic<std::uint64_t> rodada_atual;
+};